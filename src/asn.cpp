@@ -8,24 +8,6 @@ namespace dflat
 
 using std::move;
 
-String opString(OpType op)
-{
-    switch(op)
-    {
-        case opPlus:        return "+";
-        case opMinus:       return "-";
-        case opDiv:         return "/";
-        case opMult:        return "*";
-        case opNot:         return "!";
-        case opAnd:         return "&&";
-        case opOr:          return "||";
-        case opLogEq:       return "==";
-        case opLogNotEq:    return "!=";
-    }
-
-    std::abort(); // Unhandled op.
-}
-
 bool operator==(ASNPtr const& a, ASNPtr const& b)
 {
     if (!a && !b)
@@ -73,12 +55,12 @@ ASN::~ASN()
 }
 
 //VariableExp:
-VariableExp::VariableExp(String const& name_)
+VariableExp::VariableExp(Symbol const& name_)
     : name(name_)
 {
 }
 
-VariableExp::VariableExp(String const& object_, String const& member_)
+VariableExp::VariableExp(Symbol const& object_, Symbol const& member_)
     : object(object_), name(member_)
 {
 }
@@ -87,11 +69,11 @@ String VariableExp::toString() const
 {
     if (object)
     {
-        return *object + "." + name;
+        return object->str() + "." + name.str();
     }
     else
     {
-        return name;
+        return name.str();
     }
 }
 
@@ -145,12 +127,28 @@ String UnopExp::toString() const
     return "(" + opString(op) + rhs->toString() + ")";
 }
 
+// Heap list for trees built by hand.
+static ASNList toList(Vector<ASNPtr>&& v)
+{
+    return ASNList(make_move_iterator(v.begin()), make_move_iterator(v.end()));
+}
+
+static ArgList toArgs(Vector<FormalArg> const& v)
+{
+    return ArgList(v.begin(), v.end());
+}
+
 //Block:
-Block::Block(Vector<ASNPtr>&& _statements)
+Block::Block(ASNList&& _statements)
     : statements(move(_statements))
 {
 }
 
+Block::Block(Vector<ASNPtr>&& _statements)
+    : statements(toList(move(_statements)))
+{
+}
+
 String Block::toString() const
 {
     String s = "{\n";
@@ -197,8 +195,8 @@ String WhileStm::toString() const
 }
 
 //MethodDef:
-MethodDef::MethodDef(String _retTypeName, String _name,
-             Vector<FormalArg>&& _args, BlockPtr&& _statements)
+MethodDef::MethodDef(TypeName _retTypeName, Symbol _name,
+             ArgList&& _args, BlockPtr&& _statements)
     : retTypeName(_retTypeName)
     , name(_name)
     , args(move(_args))
@@ -206,15 +204,21 @@ MethodDef::MethodDef(String _retTypeName, String _name,
 {
 }
 
+MethodDef::MethodDef(TypeName _retTypeName, Symbol _name,
+             Vector<FormalArg>&& _args, BlockPtr&& _statements)
+    : MethodDef(_retTypeName, _name, toArgs(_args), move(_statements))
+{
+}
+
 String MethodDef::toString() const
 {
-    String str = retTypeName + " " + name + "(";
+    String str = retTypeName.str() + " " + name.str() + "(";
     int track = 0;
     for(auto&& ar : args)
     {
         if(track > 0)
             str += ", ";
-        str += ar.typeName + " " + ar.name;
+        str += ar.typeName.str() + " " + ar.name.str();
         ++track;
     }
     str += ")\n";
@@ -223,12 +227,17 @@ String MethodDef::toString() const
 }
 
 //ConsDef:
-ConsDef::ConsDef(Vector<FormalArg>&& _args, BlockPtr&& _statements)
+ConsDef::ConsDef(ArgList&& _args, BlockPtr&& _statements)
     : args(move(_args))
     , statements(move(_statements))
 {
 }
 
+ConsDef::ConsDef(Vector<FormalArg>&& _args, BlockPtr&& _statements)
+    : ConsDef(toArgs(_args), move(_statements))
+{
+}
+
 String ConsDef::toString() const
 {
     String str = "cons(";
@@ -237,7 +246,7 @@ String ConsDef::toString() const
     {
         if(track > 0)
             str += ", ";
-        str += ar.typeName + " " + ar.name;
+        str += ar.typeName.str() + " " + ar.name.str();
         ++track;
     }
     str += ")\n";
@@ -246,11 +255,16 @@ String ConsDef::toString() const
 }
 
 //MethodExp:
-MethodExp::MethodExp(Variable _method, Vector<ASNPtr>&& _args)
+MethodExp::MethodExp(Variable _method, ASNList&& _args)
     : method(move(_method)), args(move(_args))
 {
 }
 
+MethodExp::MethodExp(Variable _method, Vector<ASNPtr>&& _args)
+    : method(move(_method)), args(toList(move(_args)))
+{
+}
+
 String MethodExp::toString() const
 {
     String str = method.toString() + "(";
@@ -278,14 +292,19 @@ String MethodStm::toString() const
 }
 
 //NewExp:
-NewExp::NewExp(String _typeName, Vector<ASNPtr>&& _args)
+NewExp::NewExp(TypeName _typeName, ASNList&& _args)
     : typeName(_typeName), args(move(_args))
 {
 }
 
+NewExp::NewExp(TypeName _typeName, Vector<ASNPtr>&& _args)
+    : typeName(_typeName), args(toList(move(_args)))
+{
+}
+
 String NewExp::toString() const
 {
-    String str = "new " + typeName + " (";
+    String str = "new " + typeName.str() + " (";
     size_t track = 0;
     for(auto&& ar : args)
     {
@@ -310,25 +329,25 @@ String AssignStm::toString() const
 }
 
 //VarDecStm:
-VarDecStm::VarDecStm(String _typeName, String _name)
+VarDecStm::VarDecStm(TypeName _typeName, Symbol _name)
     : typeName(_typeName), name(_name)
 {
 }
 
 String VarDecStm::toString() const
 {
-    return typeName + " " + name + ";";
+    return typeName.str() + " " + name.str() + ";";
 }
 
 //VarDecAssignStm:
-VarDecAssignStm::VarDecAssignStm(String _typeName, String _name, ASNPtr&& _value)
+VarDecAssignStm::VarDecAssignStm(TypeName _typeName, Symbol _name, ASNPtr&& _value)
     : typeName(_typeName), name(_name), value(move(_value))
 {
 }
 
 String VarDecAssignStm::toString() const
 {
-    return typeName + " " + name + " = " + value->toString() + ";";
+    return typeName.str() + " " + name.str() + " = " + value->toString() + ";";
 }
 
 //RetStm:
@@ -354,16 +373,21 @@ String PrintStm::toString() const
 }
 
 // Class Definition
-ClassDecl::ClassDecl(String _name, Vector<ASNPtr>&& _members, ClassDecl* _parent)
+ClassDecl::ClassDecl(Symbol _name, ASNList&& _members, ClassDecl* _parent)
     : name(_name), members(move(_members)), parent(_parent)
 {
 }
 
+ClassDecl::ClassDecl(Symbol _name, Vector<ASNPtr>&& _members, ClassDecl* _parent)
+    : name(_name), members(toList(move(_members))), parent(_parent)
+{
+}
+
 String ClassDecl::toString() const
 {
-    String str = "class " + name;
+    String str = "class " + name.str();
     if(parent)
-        str += " extends " + parent->name;
+        str += " extends " + parent->name.str();
     str += "\n{\n";
     for(auto&& ex : members)
         str += ex->toString() + "\n\n";
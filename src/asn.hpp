@@ -5,11 +5,14 @@
 #define ASN_HPP
 
 #include <memory>
+#include <type_traits>
 #include "string.hpp"
 #include "vector.hpp"
 #include "variable.hpp"
+#include "optype.hpp"
 #include "typechecker_tools.hpp"
 #include "codegenerator_tools.hpp"
+#include "astarena.hpp"
 
 namespace dflat
 {
@@ -19,16 +22,11 @@ enum ASNType { expBinop, expNumber, expBool, expVariable, expUnop,
                 stmMethod, expMethod, stmVarDecAssign, expNew, stmRet,
                 declMethod, declClass, expThis, stmVarDec, stmPrint };
 
-enum OpType { opPlus, opMinus, opMult, opDiv, opNot, opAnd, opOr,
-                opLogEq, opLogNotEq };
-
-String opString(OpType);
-
 // Type for method definition arguments.
 struct FormalArg
 {
     TypeName typeName;
-    String name;
+    Symbol name;
 };
 
 inline
@@ -38,6 +36,8 @@ bool operator ==(FormalArg const& a, FormalArg const& b)
         && a.name     == b.name;
 }
 
+using ArgList = std::vector<FormalArg, ArenaAllocator<FormalArg>>;
+
 class ASN
 {
     //Base class for all ASN types
@@ -79,10 +79,39 @@ class ASN
     } \
     /*end DECL_CMP*/
 
-using ASNPtr = std::unique_ptr<ASN>;
+// Makes a node in arena, or on the heap if there's none.
+template <typename T, typename... Args>
+std::unique_ptr<T, ASNDelete> makeNode(ASTArena* arena, Args&&... args)
+{
+    if (!arena)
+    {
+        return std::unique_ptr<T, ASNDelete>(new T(std::forward<Args>(args)...));
+    }
+
+    T* node = new (arena->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    return std::unique_ptr<T, ASNDelete>(node, ASNDelete(false));
+}
+
+// Empty child list, in arena if given.
+inline ASNList makeList(ASTArena* arena)
+{
+    return ASNList(ArenaAllocator<ASNPtr>(arena));
+}
+
+// Empty argument list, in arena if given.
+inline ArgList makeArgs(ASTArena* arena)
+{
+    return ArgList(ArenaAllocator<FormalArg>(arena));
+}
 
-class Block;
-using BlockPtr = std::unique_ptr<Block>;
+// Arena nodes are never destroyed; release just drops the chunks.
+// So a node's fields are child pointers and lists held in the arena,
+//  or values with nothing to destroy.
+static_assert(std::is_trivially_destructible_v<FormalArg>
+        && std::is_trivially_destructible_v<Variable>
+        && std::is_trivially_destructible_v<Optional<Type>>
+        && std::is_trivially_destructible_v<Optional<MethodMeta>>,
+        "AST node fields must not own memory outside the arena");
 
 bool operator==(ASNPtr const&, ASNPtr const&);
 bool operator!=(ASNPtr const&, ASNPtr const&);
@@ -94,11 +123,11 @@ class VariableExp : public ASN
     //Example Input: var
     //Example Input (as member variable): obj.var
     public:
-        Optional<String> object;
-        String name;
+        Optional<Symbol> object;
+        Symbol name;
 
-        VariableExp(String const&); // var or implicit this.member
-        VariableExp(String const&, String const&); // object, member
+        VariableExp(Symbol const&); // var or implicit this.member
+        VariableExp(Symbol const&, Symbol const&); // object, member
         ASNType getType() const { return expVariable; }
         String toString() const;
         Type typeCheckPrv(TypeEnv&);
@@ -202,8 +231,9 @@ class UnopExp : public ASN
 class Block : public ASN
 {
     public:
-        Vector<ASNPtr> statements;
+        ASNList statements;
         Block() = default;
+        Block(ASNList&&);
         Block(Vector<ASNPtr>&&);
         ASNType getType() const { return block; }
         String toString() const;
@@ -270,12 +300,13 @@ class MethodDef : public ASN
 {
     //Example Input: int func(int x, int y) { statement }
     public:
-        String retTypeName;
-        String name;
-        Vector<FormalArg> args;
+        TypeName retTypeName;
+        Symbol name;
+        ArgList args;
         BlockPtr statements;
 
-        MethodDef(String, String, Vector<FormalArg>&&, BlockPtr&&);
+        MethodDef(TypeName, Symbol, ArgList&&, BlockPtr&&);
+        MethodDef(TypeName, Symbol, Vector<FormalArg>&&, BlockPtr&&);
         ASNType getType() const { return defMethod; }
         String toString() const;
         Type typeCheckPrv(TypeEnv&);
@@ -296,9 +327,10 @@ class ConsDef : public ASN
 {
     //Example Input: cons(int x, int y) { statements }
     public:
-        Vector<FormalArg> args;
+        ArgList args;
         BlockPtr statements;
 
+        ConsDef(ArgList&&, BlockPtr&&);
         ConsDef(Vector<FormalArg>&&, BlockPtr&&);
         ASNType getType() const { return defMethod; }
         String toString() const;
@@ -319,8 +351,12 @@ class MethodExp : public ASN
     //Example Input: func(var, 1)
     public:
         Variable method;
-        Vector<ASNPtr> args;
+        ASNList args;
+
+        // Resolved by typechecking: defining class and canonical name.
+        Optional<MethodMeta> callMeta;
 
+        MethodExp(Variable, ASNList&&);
         MethodExp(Variable, Vector<ASNPtr>&&);
         ASNType getType() const { return expMethod; }
         String toString() const;
@@ -383,11 +419,11 @@ class VarDecStm : public ASN
 {
     //Example Input: int x;
     public:
-        String typeName;
-        String name;
+        TypeName typeName;
+        Symbol name;
 
         // first: type, second: name, third: exp
-        VarDecStm(String, String);
+        VarDecStm(TypeName, Symbol);
         ASNType getType() const { return stmVarDec; }
         String toString() const;
         Type typeCheckPrv(TypeEnv&);
@@ -406,12 +442,12 @@ class VarDecAssignStm : public ASN
 {
     //Example Input: int x = 5;
     public:
-        String typeName;
-        String name;
+        TypeName typeName;
+        Symbol name;
         ASNPtr value;
 
         // first: type, second: name, third: exp
-        VarDecAssignStm(String, String, ASNPtr&&);
+        VarDecAssignStm(TypeName, Symbol, ASNPtr&&);
         ASNType getType() const { return stmVarDecAssign; }
         String toString() const;
         Type typeCheckPrv(TypeEnv&);
@@ -471,10 +507,14 @@ class NewExp : public ASN
 {
     //Example Input: new type(exp, exp)
     public:
-        String typeName;
-        Vector<ASNPtr> args;
+        TypeName typeName;
+        ASNList args;
 
-        NewExp(String, Vector<ASNPtr>&&);
+        // Resolved by typechecking: class and constructor's canonical name.
+        Optional<MethodMeta> callMeta;
+
+        NewExp(TypeName, ASNList&&);
+        NewExp(TypeName, Vector<ASNPtr>&&);
         ASNType getType() const { return expNew; }
         String toString() const;
         Type typeCheckPrv(TypeEnv&);
@@ -498,15 +538,21 @@ class ClassDecl : public ASN
     };
     */
     public:
-        String name;
-        Vector<ASNPtr> members;
+        Symbol name;
+        ASNList members;
         ClassDecl* parent;
 
-        ClassDecl(String, Vector<ASNPtr>&&, ClassDecl*); 
+        ClassDecl(Symbol, ASNList&&, ClassDecl*);
+        ClassDecl(Symbol, Vector<ASNPtr>&&, ClassDecl*);
         ASNType getType() const { return declClass; }
         String toString() const;
         Type typeCheckPrv(TypeEnv&);
         void generateCode(GenEnv &) const;
+
+        // The two halves of generateCode, for emitting every struct
+        //  before any function.
+        void generateStruct(GenEnv &) const;
+        void generateFunctions(GenEnv &) const;
         
         bool operator==(ClassDecl const& other) const
         {
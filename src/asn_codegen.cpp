@@ -114,8 +114,8 @@ void WhileStm::generateCode(GenEnv & env) const
 
 static
 void emitMethod(GenEnv& env, CanonName const& methodName, 
-        ValueType const& retType, Vector<FormalArg> const& args,
-        Vector<ASNPtr> const& body, bool isCons)
+        ValueType const& retType, ArgList const& args,
+        ASNList const& body, bool isCons)
 {
     env.enterMethod(methodName);
     ValueType const curClass = env.curClass().type;
@@ -187,7 +187,7 @@ void MethodDef::generateCode(GenEnv & env) const
 
 static
 void emitConstructor(GenEnv& env, MethodType const& consType, 
-        Vector<FormalArg> const& args, Vector<ASNPtr> const& body)
+        ArgList const& args, ASNList const& body)
 {
     CanonName const consName(config::consName, consType);
     ValueType const retType = env.curClass().type;
@@ -201,11 +201,15 @@ void ConsDef::generateCode(GenEnv & env) const
 
 void MethodExp::generateCode(GenEnv & env) const
 {
-    String const objectName = method.object ? *method.object 
+    Symbol const objectName = method.object ? *method.object 
                                             : config::thisName;
 
-    auto [thisType, methodName] = env.getMethodMeta(this);
-    ValueType objectType = env.getLocalType(objectName);
+    if (!callMeta)
+    {
+        throw std::logic_error("No method meta for '" + toString() + "'");
+    }
+
+    CanonName const& methodName = callMeta->methodName;
 
     env << CodeLiteral("CALL(")
         << CodeTypeName(asnType->value())
@@ -235,8 +239,12 @@ void NewExp::generateCode(GenEnv& env) const
     ValueType const resultType(typeName);
 
     // Need constructor's canonical name.
-    auto [thisType, consName] = env.getMethodMeta(this);
-    (void)thisType; // unused.
+    if (!callMeta)
+    {
+        throw std::logic_error("No method meta for '" + toString() + "'");
+    }
+
+    auto const& [thisType, consName] = *callMeta;
 
     // Sanity check.
     if (resultType != thisType)
@@ -333,6 +341,12 @@ void PrintStm::generateCode(GenEnv& env) const
 }
 
 void ClassDecl::generateCode(GenEnv& env) const
+{
+    generateStruct(env);
+    generateFunctions(env);
+}
+
+void ClassDecl::generateStruct(GenEnv& env) const
 {
     ValueType const classType(name);
     env.enterClass(classType);
@@ -358,15 +372,14 @@ void ClassDecl::generateCode(GenEnv& env) const
         env << CodeTabs()
             << CodeLiteral("struct vtable vtable;\n");
     }
-    
-    // Emit default constructor.
-    // TODO - if you define your own default constructor, this implicit one should not be emitted.
-    emitConstructor(env, MethodType(classType, {}), {}, {});
 
-    // Emit members.
+    // Emit member vars.
     for (ASNPtr const& member : members)
     {
-        env << member;
+        if (member->getType() != defMethod)
+        {
+            env << member;
+        }
     }
 
     env << CodeTabOut()
@@ -375,4 +388,25 @@ void ClassDecl::generateCode(GenEnv& env) const
     env.leaveClass();
 }
 
+void ClassDecl::generateFunctions(GenEnv& env) const
+{
+    ValueType const classType(name);
+    env.enterClass(classType);
+
+    // Emit default constructor.
+    // TODO - if you define your own default constructor, this implicit one should not be emitted.
+    emitConstructor(env, MethodType(classType, {}), {}, {});
+
+    // Emit methods and constructors.
+    for (ASNPtr const& member : members)
+    {
+        if (member->getType() == defMethod)
+        {
+            env << member;
+        }
+    }
+
+    env.leaveClass();
+}
+
 } //namespace dflat
@@ -48,8 +48,8 @@ Type BoolExp::typeCheckPrv(TypeEnv&)
 
 Type BinopExp::typeCheckPrv(TypeEnv& env)
 {
-    // Look up the type by the canonical name for this operation.
-    // e.g. "1 + 2" might be "+(int,int)" with type int.
+    // Look up the type by the operator and operand types.
+    // e.g. "1 + 2" is +(int,int) with type int.
     Type lhsType = lhs->typeCheck(env);
     Type rhsType = rhs->typeCheck(env);
         
@@ -63,15 +63,13 @@ Type BinopExp::typeCheckPrv(TypeEnv& env)
         throw TypeCheckerException("Using method as operator rhs");
     }
 
-    MethodType const type(undefinedType, { lhsType.value(), rhsType.value() });
-    CanonName const canonName(opString(op), type);
-    return env.lookupRuleType(canonName);
+    return env.lookupOpType(op, lhsType.value(), rhsType.value());
 }
 
 Type UnopExp::typeCheckPrv(TypeEnv& env)
 {
-    // Look up the type by the canonical name for this operation.
-    // e.g. "-1" might be "-(int)" with type int.
+    // Look up the type by the operator and operand type.
+    // e.g. "-1" is -(int) with type int.
     Type rhsType = rhs->typeCheck(env);
     
     if (!rhsType.isValue())
@@ -79,9 +77,7 @@ Type UnopExp::typeCheckPrv(TypeEnv& env)
         throw TypeCheckerException("Using method as operator rhs");
     }
    
-    MethodType const type(undefinedType, { rhsType.value() });
-    CanonName const canonName(opString(op), type);
-    return env.lookupRuleType(canonName);
+    return env.lookupOpType(op, rhsType.value());
 }
 
 Type Block::typeCheckPrv(TypeEnv& env)
@@ -147,7 +143,6 @@ Type PrintStm::typeCheckPrv(TypeEnv& env)
 Type MethodDef::typeCheckPrv(TypeEnv& env)
 {
     MethodType methodType(ValueType(retTypeName), {});
-    ValueType const curClass = env.curClass().type;
 
     for (FormalArg const& arg : args)
     {
@@ -203,7 +198,7 @@ Type ConsDef::typeCheckPrv(TypeEnv& env)
 Type MethodExp::typeCheckPrv(TypeEnv& env)
 {
     // If no name, use implicit "this".
-    String objectName = (method.object ? *method.object : config::thisName);
+    Symbol objectName = (method.object ? *method.object : config::thisName);
 
     // Get method's class.
     ValueType objectType = env.lookupVarType(objectName);
@@ -232,7 +227,7 @@ Type MethodExp::typeCheckPrv(TypeEnv& env)
     
     // Get return type for whatever has this canonical name.
     Type resultType = env.lookupMethodTypeByClass(objectType, methodName).ret();
-    env.setMethodMeta(this, objectType, methodName); // Needed later.
+    callMeta = env.methodMeta(objectType, methodName); // Needed later.
     return resultType;
 }
 
@@ -279,7 +274,7 @@ Type NewExp::typeCheckPrv(TypeEnv& env)
                 + "' returns '" + resultType.toString() + "'");
     }
 
-    env.setMethodMeta(this, type, consName); // Needed later.
+    callMeta = env.methodMeta(type, consName); // Needed later.
     return type;
 }
 
@@ -0,0 +1,50 @@
+#include "astarena.hpp"
+#include "asn.hpp"
+#include <algorithm>
+
+namespace dflat
+{
+
+ASTArena::~ASTArena()
+{
+    release();
+}
+
+void* ASTArena::allocate(size_t size, size_t align)
+{
+    size_t const pad = (align - reinterpret_cast<uintptr_t>(_next) % align) % align;
+
+    if (!_next || size + pad > static_cast<size_t>(_end - _next))
+    {
+        // Oversized requests get a chunk of their own.
+        size_t const bytes = std::max(chunkSize, size + align);
+        // Not make_unique, which would zero the chunk.
+        _chunks.push_back(std::unique_ptr<char[]>(new char[bytes]));
+        _next = _chunks.back().get();
+        _end = _next + bytes;
+        return allocate(size, align);
+    }
+
+    void* p = _next + pad;
+    _next += pad + size;
+    _used += pad + size;
+    return p;
+}
+
+void ASTArena::release()
+{
+    _chunks.clear();
+    _next = nullptr;
+    _end = nullptr;
+    _used = 0;
+}
+
+void ASNDelete::operator()(ASN* p) const
+{
+    if (heap)
+    {
+        delete p;
+    }
+}
+
+} // namespace dflat
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "vector.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace dflat
+{
+
+class ASN;
+class Block;
+
+// Bump allocator for one compilation's AST.
+// Nodes and their child and argument lists are carved out of large chunks.
+// Nothing in them owns memory elsewhere, so nodes are never destroyed:
+//  release hands the chunks back together, whatever the tree's size.
+class ASTArena
+{
+    public:
+        ASTArena() = default;
+        ~ASTArena();
+
+        ASTArena(ASTArena const&) = delete;
+        ASTArena& operator=(ASTArena const&) = delete;
+
+        void* allocate(size_t size, size_t align);
+        void release();
+
+        size_t bytesUsed() const { return _used; }
+
+    private:
+        static constexpr size_t chunkSize = 64 * 1024;
+
+        Vector<std::unique_ptr<char[]>> _chunks;
+        char* _next = nullptr;
+        char* _end = nullptr;
+        size_t _used = 0;
+};
+
+// Allocator for containers in AST nodes.
+// Uses the arena when given one, the heap otherwise.
+template <typename T>
+class ArenaAllocator
+{
+    ASTArena* _arena;
+
+    public:
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        ArenaAllocator(ASTArena* arena = nullptr) noexcept
+            : _arena(arena)
+        {}
+
+        template <typename U>
+        ArenaAllocator(ArenaAllocator<U> const& other) noexcept
+            : _arena(other.arena())
+        {}
+
+        T* allocate(size_t n)
+        {
+            if (_arena)
+            {
+                return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+            }
+
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, size_t n) noexcept
+        {
+            // Arena memory goes back all at once on release.
+            if (!_arena)
+            {
+                std::allocator<T>().deallocate(p, n);
+            }
+        }
+
+        ASTArena* arena() const noexcept { return _arena; }
+
+        template <typename U>
+        bool operator==(ArenaAllocator<U> const& other) const noexcept
+        {
+            return _arena == other.arena();
+        }
+
+        template <typename U>
+        bool operator!=(ArenaAllocator<U> const& other) const noexcept
+        {
+            return _arena != other.arena();
+        }
+};
+
+// Deletes heap nodes. Arena nodes are left to their arena.
+struct ASNDelete
+{
+    bool heap = true;
+
+    ASNDelete() = default;
+
+    explicit ASNDelete(bool heap_)
+        : heap(heap_)
+    {}
+
+    // So make_unique results convert to ASNPtr.
+    template <typename T>
+    ASNDelete(std::default_delete<T> const&)
+    {}
+
+    void operator()(ASN*) const;
+};
+
+using ASNPtr = std::unique_ptr<ASN, ASNDelete>;
+using BlockPtr = std::unique_ptr<Block, ASNDelete>;
+using ASNList = std::vector<ASNPtr, ArenaAllocator<ASNPtr>>;
+
+} // namespace dflat
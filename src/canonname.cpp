@@ -4,13 +4,34 @@
 namespace dflat
 {
 
-static
-String mkCanonName(String const& base, MethodType const& type)
+CanonName::CanonName(Symbol base, ValueType const& ret, 
+        ValueType const* args, size_t count)
+    : _baseName(base)
+    , _type(TypeTable::global().intern(ret, args, count))
+    , _args(TypeTable::global().intern(undefinedType, args, count))
+    , _hash(base.hash() * 31 + _args)
+{}
+
+CanonName::CanonName(Symbol base, MethodType const& type)
+    : CanonName(base, type.ret(), type.args().data(), type.args().size())
+{}
+
+CanonName::CanonName(Symbol base, ValueType const& ret, 
+        std::initializer_list<ValueType> args)
+    : CanonName(base, ret, args.begin(), args.size())
+{}
+
+Symbol const& CanonName::baseName() const
+{
+    return _baseName;
+}
+
+String CanonName::canonName() const
 {
-    String s = base + "(";
+    String s = _baseName.str() + "(";
     bool first = true;
 
-    for (ValueType const& arg : type.args())
+    for (ValueType const& arg : type().args())
     {
         if (first)
         {
@@ -28,30 +49,20 @@ String mkCanonName(String const& base, MethodType const& type)
     return s;
 }
 
-CanonName::CanonName(String base, MethodType const& type)
-    : _baseName(std::move(base))
-    , _type(type)
-    , _canonName(mkCanonName(_baseName, _type))
-{}
-
-String const& CanonName::baseName() const
-{
-    return _baseName;
-}
-
-String const& CanonName::canonName() const
+MethodType const& CanonName::type() const
 {
-    return _canonName;
+    return TypeTable::global().method(_type);
 }
 
-MethodType const& CanonName::type() const
+TypeId CanonName::argsId() const
 {
-    return _type;
+    return _args;
 }
 
 bool operator==(CanonName const& a, CanonName const& b)
 {
-    return a.canonName() == b.canonName();
+    return a.baseName() == b.baseName()
+        && a.argsId() == b.argsId();
 }
 
 bool operator!=(CanonName const& a, CanonName const& b)
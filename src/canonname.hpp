@@ -2,23 +2,35 @@
 
 #include "string.hpp"
 #include "type.hpp"
+#include <initializer_list>
 #include <iosfwd>
 
 namespace dflat
 {
 
+// A method's name with its argument types, e.g. f(int,bool).
+// Two names are the same method when their base names and argument types
+//  match; the return type is carried along but not part of the key.
+// Both types are interned, so copying, comparing and hashing don't
+//  allocate; the text is only built when asked for.
 class CanonName
 {
     public:
-        CanonName(String, MethodType const&);
-        String const& baseName() const;
-        String const& canonName() const;
+        CanonName(Symbol, MethodType const&);
+        CanonName(Symbol, ValueType const& ret, std::initializer_list<ValueType> args);
+        Symbol const& baseName() const;
+        String canonName() const; // For messages.
         MethodType const& type() const;
+        TypeId argsId() const; // Interned args, with undefined return.
+        size_t hash() const { return _hash; }
 
     private:
-        String _baseName;
-        MethodType _type;
-        String _canonName;
+        CanonName(Symbol, ValueType const& ret, ValueType const* args, size_t count);
+
+        Symbol _baseName;
+        TypeId _type;
+        TypeId _args;
+        size_t _hash;
 };
 
 bool operator==(CanonName const&, CanonName const&);
@@ -35,7 +47,7 @@ struct hash<dflat::CanonName>
 {
     size_t operator()(dflat::CanonName const& x) const
     {
-        return std::hash<dflat::String>{}(x.canonName());
+        return x.hash();
     }
 };
 
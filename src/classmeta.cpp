@@ -15,6 +15,29 @@ void ClassMetaMan::enter(ValueType const& classType)
 
 void ClassMetaMan::leave()
 {
+    ClassMeta* classMeta = _curClass ? _lookup(*_curClass) : nullptr;
+
+    if (classMeta && !classMeta->closed)
+    {
+        // Parents come first, so theirs are already complete.
+        ClassMeta const* parent = classMeta->parent ? lookup(*classMeta->parent) : nullptr;
+
+        if (parent)
+        {
+            for (auto const& [baseName, inherited] : parent->overloads)
+            {
+                Vector<Overload>& overloads = classMeta->overloads[baseName];
+
+                for (Overload const& o : inherited)
+                {
+                    overloads.push_back({ o.name, o.depth + 1 });
+                }
+            }
+        }
+
+        classMeta->closed = true;
+    }
+
     _curClass = nullopt;
 }
 
@@ -26,6 +49,7 @@ void ClassMetaMan::declare(ValueType const& type)
     {
         auto result = _classes.insert({ type, ClassMeta(type) });
         it = result.first;
+        _declOrder.push_back(type);
     }
 
     // Already declared OK. Handle in user.
@@ -41,42 +65,61 @@ ClassMeta const* ClassMetaMan::lookup(ValueType const& type) const
     return dflat::lookup(_classes, type);
 }
 
-Optional<MemberMeta> ClassMetaMan::lookupVar(ValueType const& classType,
-        String const& memberName) const
+// Finds key in the given table of classType.
+template <typename K>
+static
+Optional<MemberMeta> lookupMember(Map<ValueType, ClassMeta> const& classes,
+        ValueType const& classType, Map<K, MemberMeta> ClassMeta::* table, K const& key)
 {
-    int depth = 1;
-    ClassMeta const* cm = dflat::lookup(_classes, classType);
+    ClassMeta const* cm = dflat::lookup(classes, classType);
+    MemberMeta const* member = cm ? dflat::lookup(cm->*table, key) : nullptr;
 
-    while (cm)
+    if (!member)
     {
-        Type const* memberType = dflat::lookup(cm->members, memberName);
+        return nullopt;
+    }
 
-        if (memberType)
-        {
-            return MemberMeta{ depth, *memberType, cm->type };
-        }
-        else
-        {
-            ++depth;
+    return *member;
+}
 
-            if (cm->parent)
-            {
-                cm = lookup(cm->parent.value());
-            }
-            else
-            {
-                cm = nullptr;
-            }
-        }
+// Own members shadow inherited ones. The first declaration of a key wins.
+// Returns whether key is newly our own.
+template <typename K>
+static
+bool addOwnMember(Map<K, MemberMeta>& table, K const& key, MemberMeta const& member)
+{
+    auto [it, added] = table.insert({ key, member });
+
+    if (!added && it->second.depth > 1)
+    {
+        it->second = member;
+        return true;
     }
 
-    return nullopt;
+    return added;
+}
+
+// Adds the parent's members one level further away, under any of our own.
+template <typename K>
+static
+void inheritMembers(Map<K, MemberMeta>& table, Map<K, MemberMeta> const& inherited)
+{
+    for (auto const& [key, member] : inherited)
+    {
+        table.insert({ key, MemberMeta{ member.depth + 1, member.type, member.baseClassType } });
+    }
+}
+
+Optional<MemberMeta> ClassMetaMan::lookupVar(ValueType const& classType,
+        Symbol const& memberName) const
+{
+    return lookupMember(_classes, classType, &ClassMeta::vars, memberName);
 }
 
 Optional<MemberMeta> ClassMetaMan::lookupMethod(ValueType const& classType,
         CanonName const& methodName) const
 {
-    return lookupVar(classType, methodName.canonName());
+    return lookupMember(_classes, classType, &ClassMeta::methodMembers, methodName);
 }
         
 Map<ValueType, ClassMeta> const& ClassMetaMan::allClasses() const
@@ -84,6 +127,11 @@ Map<ValueType, ClassMeta> const& ClassMetaMan::allClasses() const
     return _classes;
 }
 
+Vector<ValueType> const& ClassMetaMan::declOrder() const
+{
+    return _declOrder;
+}
+
 ClassMeta const* ClassMetaMan::cur() const
 {
     if (!_curClass)
@@ -94,42 +142,53 @@ ClassMeta const* ClassMetaMan::cur() const
     return lookup(*_curClass);
 }
 
-void ClassMetaMan::addVar(String const& name, ValueType const& type)
+// The current class, to change. what says what needed it.
+ClassMeta& ClassMetaMan::_cur(char const* what)
 {
-    if (!cur())
+    ClassMeta* classMeta = _curClass ? _lookup(*_curClass) : nullptr;
+
+    if (!classMeta)
     {
-        throw std::logic_error("adding member when no current class");
+        throw std::logic_error(String(what) + " when no current class");
     }
 
-    ClassMeta* classMeta = _lookup(cur()->type);
-    classMeta->members.insert({ name, type });
+    return *classMeta;
 }
 
-void ClassMetaMan::addMethod(CanonName const& methodName)
+void ClassMetaMan::addVar(Symbol const& name, ValueType const& type)
 {
-    if (!cur())
-    {
-        throw std::logic_error("adding member when no current class");
-    }
+    ClassMeta& classMeta = _cur("adding member");
+    addOwnMember(classMeta.vars, name, MemberMeta{ 1, type, classMeta.type });
+}
 
-    ClassMeta* classMeta = _lookup(cur()->type);
-    classMeta->members.insert({ methodName.canonName(), methodName.type() });
+void ClassMetaMan::addMethod(CanonName const& methodName)
+{
+    ClassMeta& classMeta = _cur("adding member");
+    bool const added = addOwnMember(classMeta.methodMembers, methodName,
+            MemberMeta{ 1, methodName.type(), classMeta.type });
 
-    if (methodName.baseName() != config::consName)
+    if (added && methodName.baseName() != config::consName)
     {
-        classMeta->methods.insert(methodName);
+        classMeta.methods.push_back(methodName);
+        classMeta.overloads[methodName.baseName()].push_back({ methodName, 1 });
     }
 }
 
 void ClassMetaMan::setParent(ValueType const& parentType)
 {
-    if (!cur())
+    ClassMeta& classMeta = _cur("setting parent");
+    classMeta.parent = parentType;
+
+    // Parents are declared first, so their displays are final.
+    ClassMeta const* parent = lookup(parentType);
+    classMeta.display = parent ? parent->display : Vector<ValueType>{ parentType };
+    classMeta.display.push_back(classMeta.type);
+
+    if (parent && parent != &classMeta)
     {
-        throw std::logic_error("setting parent when no current class");
+        inheritMembers(classMeta.vars, parent->vars);
+        inheritMembers(classMeta.methodMembers, parent->methodMembers);
     }
-    
-    ClassMeta* classMeta = _lookup(cur()->type);
-    classMeta->parent = parentType;
 }
 
 void ClassMetaMan::print() const
@@ -144,12 +203,14 @@ void ClassMetaMan::print() const
             std::cout << " extends " << cv.parent->toString();
         }
 
-        if (!cv.members.empty())
+        for (auto [mk,mv] : cv.vars)
         {
-            for (auto [mk,mv] : cv.members)
-            {
-                std::cout << "\n\t" << mk;
-            }
+            std::cout << "\n\t" << mk.str();
+        }
+
+        for (auto [mk,mv] : cv.methodMembers)
+        {
+            std::cout << "\n\t" << mk;
         }
     }
     if (_curClass)
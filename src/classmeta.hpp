@@ -6,12 +6,27 @@
 #include "type.hpp"
 #include "canonname.hpp"
 #include "optional.hpp"
+#include "vector.hpp"
 
 namespace dflat
 {
 
 struct MethodExp;
 
+// A method visible in a class. Depth 1 is the class's own.
+struct Overload
+{
+    CanonName name;
+    int depth;
+};
+
+struct MemberMeta
+{
+    int depth;
+    Type type;
+    ValueType baseClassType;
+};
+
 struct ClassMeta
 {
     // Class type.
@@ -20,29 +35,43 @@ struct ClassMeta
     // Parent type.
     Optional<ValueType> parent;
 
-    // Map of all members from "canonical name" to type.
-    // It's not an actual canonical name, just a String.
-    // This is so it can handle vars too. 
-    Map<String, Type> members;
+    // Ancestors from the root down, ending with this class.
+    // Each class sits at its depth in the displays of all its subclasses.
+    Vector<ValueType> display;
 
-    // Holds all non-constructor method canonical names.
-    Set<CanonName> methods;
+    // Member vars by name, inherited ones included.
+    // The parent's are copied in by setParent, so any lookup is one probe.
+    Map<Symbol, MemberMeta> vars;
+
+    // All methods, constructors too, inherited ones included.
+    Map<CanonName, MemberMeta> methodMembers;
+
+    // Own non-constructor methods, in declaration order.
+    Vector<CanonName> methods;
+
+    // Non-constructor methods by base name, nearest class first.
+    // Own methods go in as they're added, inherited ones when the
+    //  class is closed (left for the first time).
+    Map<Symbol, Vector<Overload>> overloads;
+    bool closed = false;
     
     ClassMeta(ValueType const& _type)
         : type(_type)
+        , display{ _type }
     {}
-};
 
-struct MemberMeta
-{
-    int depth;
-    Type type;
-    ValueType baseClassType;
+    // Constant time: base is this class or one of its ancestors.
+    bool isOrDerivesFrom(ClassMeta const& base) const
+    {
+        size_t const depth = base.display.size() - 1;
+        return depth < display.size() && display[depth] == base.type;
+    }
 };
 
 class ClassMetaMan
 {
     Map<ValueType, ClassMeta> _classes;
+    Vector<ValueType> _declOrder;
     Optional<ValueType> _curClass;
 
     public:
@@ -50,10 +79,14 @@ class ClassMetaMan
         void leave();
         void declare(ValueType const& classType);
         ClassMeta const* lookup(ValueType const& classType) const;
-        Optional<MemberMeta> lookupVar(ValueType const& classType, String const&) const;
+        Optional<MemberMeta> lookupVar(ValueType const& classType, Symbol const&) const;
         Optional<MemberMeta> lookupMethod(ValueType const& classType, CanonName const&) const;
         Map<ValueType, ClassMeta> const& allClasses() const;
-        void addVar(String const&, ValueType const&);
+
+        // Declared classes, first to last, for output that mustn't
+        //  depend on hash order.
+        Vector<ValueType> const& declOrder() const;
+        void addVar(Symbol const&, ValueType const&);
         void addMethod(CanonName const&);
         void setParent(ValueType const& parentType);
         ClassMeta const* cur() const;
@@ -61,6 +94,7 @@ class ClassMetaMan
 
     private:
         ClassMeta* _lookup(ValueType const& classType);
+        ClassMeta& _cur(char const* what);
 };
 
 } // namespace dflat
@@ -4,17 +4,48 @@ namespace dflat
 {
 
 String generateCode(Vector<ASNPtr> const& program, TypeEnv const& typeEnv)
+{
+    OutBuffer out;
+    generateCode(program, typeEnv, out);
+    return out.str();
+}
+
+static
+ClassDecl const& classDecl(ASNPtr const& node)
+{
+    if (node->getType() != declClass)
+    {
+        throw std::logic_error("Top-level '" + node->toString() + "' is not a class");
+    }
+
+    return static_cast<ClassDecl const&>(*node);
+}
+
+// Appends to out class by class, so a streaming out can pass code on as
+//  it's made.
+void generateCode(Vector<ASNPtr> const& program, TypeEnv const& typeEnv, OutBuffer& out)
 {
     GenEnv env(typeEnv);
 
+    // Everything the prolog needs is known after typechecking.
+    env.prolog(out);
+
+    // Any function may use any struct, so they all go first.
+    for (ASNPtr const& node : program)
+    {
+        classDecl(node).generateStruct(env);
+    }
+
+    env.flushTo(out);
+    out << "\n";
+
     for (ASNPtr const& node : program)
     {
-        node->generateCode(env);
+        classDecl(node).generateFunctions(env);
+        env.flushTo(out);
     }
 
-    return env.prolog()
-         + env.concat()
-         + env.epilog();
+    env.epilog(out);
 }
 
 } //namespace dflat
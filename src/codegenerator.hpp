@@ -8,6 +8,7 @@ namespace dflat
 {
 
 String generateCode(Vector<ASNPtr> const& program, TypeEnv const&);
+void generateCode(Vector<ASNPtr> const& program, TypeEnv const&, OutBuffer& out);
 
 } // namespace dflat
 
@@ -6,7 +6,7 @@
 namespace dflat
 {
 
-String GenEnv::prolog() const
+void GenEnv::prolog(OutBuffer& out) const
 {
 /*
     NEW(T,V,C,...)
@@ -42,7 +42,7 @@ String GenEnv::prolog() const
         It zeroes the object's memory so that unassigned members are at least predictable.
 
 */
-    String s = R"(
+    out << R"(
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -58,12 +58,12 @@ enum Methods
 
     for (CanonName const& method : getAllMethods())
     {
-        s += "\t" + mangleVTableMethodName(method) + ",\n";
+        out << "\t" << _names.vtableMethodName(method) << ",\n";
     }
 
-    s += "};\n";
+    out << "};\n";
 
-s += R"(
+    out << R"(
 typedef void* (*vtablefn)(enum Methods);
 
 struct vtable
@@ -81,177 +81,81 @@ void* dfalloc(size_t size, vtablefn vt)
 )";
 
     // Emit vtable headers.
-    for (auto [classType, meta] : _classes.allClasses())
+    for (ValueType const& classType : _classes.declOrder())
     {
-        (void)meta; // unused
-
-        s = s
-          + "void* "
-          + mangleVTableName(classType)
-          + "(enum Methods);\n";
+        out << "void* "
+            << _names.vtableName(classType)
+            << "(enum Methods);\n";
     }
 
-    s += "\n";
-    return s;
+    out << "\n";
 }
 
-static
-String vtable(GenEnv const& env, ValueType const& classType)
+void GenEnv::vtable(OutBuffer& out, ValueType const& classType) const
 {
-    String s;
-    
-    s = s
-      + "void* "
-      + mangleVTableName(classType)
-      + "(enum Methods m)\n"
-      + "{\n"
-      + "\tswitch (m)\n"
-      + "\t{\n";
-
-    for (CanonName const& methodName : env.getClassMethods(classType))
+    out << "void* "
+        << _names.vtableName(classType)
+        << "(enum Methods m)\n"
+        << "{\n"
+        << "\tswitch (m)\n"
+        << "\t{\n";
+
+    for (MethodMeta const& method : getClassMethods(classType))
     {
-        s = s
-          + "\t\tcase "
-          + mangleVTableMethodName(methodName)
-          + ": return &"
-          + mangleMethodName(classType, methodName)
-          + ";\n";
+        out << "\t\tcase "
+            << _names.vtableMethodName(method.methodName)
+            << ": return &"
+            << _names.methodName(method.thisType, method.methodName)
+            << ";\n";
     }
     
-    s = s
-      + "\t\tdefault: abort();\n"
-      + "\t}\n"
-      + "}\n\n";
-
-    return s;
+    out << "\t\tdefault: abort();\n"
+        << "\t}\n"
+        << "}\n\n";
 }
 
-String GenEnv::epilog() const
+void GenEnv::epilog(OutBuffer& out) const
 {
-    String s;
-
-    for (auto [type, meta] : _classes.allClasses())
+    for (ValueType const& type : _classes.declOrder())
     {
-        (void)meta; // unused
-        s += vtable(*this, type);
+        vtable(out, type);
     }
 
     ValueType mainClassType("Main");
-    String mainClassName("main");
+    Symbol mainClassName("main");
 
     MethodType mainMethodType(voidType, {});
     CanonName mainMethodName("main", mainMethodType);
     MethodType mainConsType(mainClassType, {});
     CanonName mainConsName(config::consName, mainConsType);
 
-    s = s
-      + "int main()\n"
-      + "{\n"
-      + "\t"
-      + mangleTypeName(mainClassType)
-      + " "
-      + mangleVarName(mainClassName)
-      + " = NEW0("
-      + mangleClassDecl(mainClassType)
-      + ", "
-      + mangleVTableName(mainClassType)
-      + ", "
-      + mangleConsName(mainConsName)
-      + ");\n"
-      + "\t"
-      + mangleMethodName(mainClassType, mainMethodName)
-      + "("
-      + mangleVarName(mainClassName)
-      + ");\n"
-      + "}\n";
-
-    return s;
-}
-
-String mangleTypeName(ValueType const& typeName)
-{
-    if (isBuiltinType(typeName))
-    {
-        return translateBuiltinType(typeName);
-    }
-    else
-    {
-        return "struct df_" + typeName.toString() + "*";
-    }
-}
-
-String mangleClassDecl(ValueType const& x)
-{
-    return "df_" + x.toString();
+    out << "int main()\n"
+        << "{\n"
+        << "\t"
+        << _names.typeName(mainClassType)
+        << " "
+        << _names.varName(mainClassName)
+        << " = NEW0("
+        << _names.classDecl(mainClassType)
+        << ", "
+        << _names.vtableName(mainClassType)
+        << ", "
+        << _names.consName(mainConsName)
+        << ");\n"
+        << "\t"
+        << _names.methodName(mainClassType, mainMethodName)
+        << "("
+        << _names.varName(mainClassName)
+        << ");\n"
+        << "}\n";
 }
 
-String mangleVarName(String const& x)
-{
-    return "df_" + x;
-}
-
-String mangleMemberName(String const& x)
-{
-    return "df_" + x;
-}
-
-static
-String argString(Vector<ValueType> const& args)
-{
-    String s;
-
-    if (args.empty())
-    {
-        s += "_";
-    }
-    else
-    {
-        for (ValueType const& arg : args)
-        {
-            s += "_" + arg.toString();
-        }
-    }
-
-    return s;
-}
-
-String mangleMethodName(ValueType const& objectType,
-        CanonName const& methodName)
-{
-    return "dfm_"
-         + objectType.toString()
-         + "_"
-         + methodName.baseName()
-         + argString(methodName.type().args());
-}
-
-String mangleConsName(CanonName const& consName)
-{
-    ValueType const objectType = consName.type().ret();
-    return "dfc_"
-         + objectType.toString()
-         + argString(consName.type().args());
-}
-
-String mangleVTableName(ValueType const& classType)
-{
-    return "dfv_" + classType.toString();
-}
-
-String mangleVTableMethodName(CanonName const& methodName)
-{
-    return "dfvm_"
-         + methodName.baseName()
-         + argString(methodName.type().args());
-}
-
-
 GenEnv::GenEnv(TypeEnv const& typeEnv)
     : _classes(typeEnv._classes)
-    , _methods(typeEnv._methods)
+    , _names(_classes)
 {}
 
-std::stringstream& GenEnv::write()
+OutBuffer& GenEnv::write()
 {
     if (!inMethod())
     {
@@ -263,21 +167,25 @@ std::stringstream& GenEnv::write()
     }
 }
 
-String GenEnv::concat() const
+void GenEnv::flushTo(OutBuffer& out)
 {
-    return _structDef.str()
-         + "\n"
-         + _funcDef.str();
+    out.splice(std::move(_structDef));
+    out.splice(std::move(_funcDef));
 }
         
 void GenEnv::enterClass(ValueType const& classType)
 {
-    _classes.enter(classType);
+    _curClass = _classes.lookup(classType);
+
+    if (!_curClass)
+    {
+        throw std::logic_error("No class of type '" + classType.toString() + "'");
+    }
 }
 
 void GenEnv::leaveClass()
 {
-    _classes.leave();
+    _curClass = nullptr;
 
     if (_classTabs != 0)
     {
@@ -287,17 +195,17 @@ void GenEnv::leaveClass()
 
 bool GenEnv::inClass() const
 {
-    return _classes.cur() != nullptr;
+    return _curClass != nullptr;
 }
 
 ClassMeta const& GenEnv::curClass() const
 {
-    if (!_classes.cur())
+    if (!_curClass)
     {
         throw std::logic_error("no curClass");
     }
 
-    return *_classes.cur();
+    return *_curClass;
 }
 
 void GenEnv::enterMethod(CanonName const& methodName)
@@ -333,21 +241,11 @@ MethodMeta const& GenEnv::curMethod() const
     return *_curMethod;
 }
         
-MethodMeta const& GenEnv::getMethodMeta(ASN const* node) const
-{
-    MethodMeta const* method = _methods.lookupMeta(node);
-
-    if (!method)
-    {
-        throw std::logic_error("No method meta for '" + node->toString() + "'");
-    }
-
-    return *method;
-}
-
-Set<CanonName> GenEnv::getClassMethods(ValueType const& classType) const
+// Methods in the order their first declarations come, root class first,
+//  each as defined by the nearest class.
+Vector<MethodMeta> GenEnv::getClassMethods(ValueType const& classType) const
 {
-    Set<CanonName> methods;
+    Vector<MethodMeta> methods;
     ClassMeta const* meta = _classes.lookup(classType);
 
     if (!meta)
@@ -355,40 +253,56 @@ Set<CanonName> GenEnv::getClassMethods(ValueType const& classType) const
         throw std::logic_error("No class of type '" + classType.toString() + "'");
     }
 
-    while (true)
+    ClassMeta const* above = nullptr;
+
+    for (ValueType const& ancestorType : meta->display)
     {
-        for (CanonName const& methodName : meta->methods)
+        ClassMeta const* ancestor = _classes.lookup(ancestorType);
+
+        if (!ancestor)
         {
-            methods.insert(methodName);
+            continue;
         }
 
-        if (!meta->parent)
+        for (CanonName const& methodName : ancestor->methods)
         {
-            break;
-        }
+            // Overrides were listed where they were first declared.
+            if (above && lookup(above->methodMembers, methodName))
+            {
+                continue;
+            }
 
-        meta = _classes.lookup(*meta->parent);
+            MemberMeta const* member = lookup(meta->methodMembers, methodName);
 
-        if (!meta)
-        {
-            throw std::logic_error("No class of type '" + meta->parent->toString() + "'");
+            if (!member)
+            {
+                throw std::logic_error("No method '" + methodName.baseName().str()
+                        + "' in '" + classType.toString() + "'");
+            }
+
+            methods.push_back(MethodMeta{ member->baseClassType, methodName });
         }
+
+        above = ancestor;
     }
 
     return methods;
 }
 
-Set<CanonName> GenEnv::getAllMethods() const
+// Every class's methods, first declared first, each once.
+Vector<CanonName> GenEnv::getAllMethods() const
 {
-    Set<CanonName> methods;
+    Vector<CanonName> methods;
+    Set<CanonName> seen;
 
-    for (auto [type, meta] : _classes.allClasses())
+    for (ValueType const& type : _classes.declOrder())
     {
-        (void)type; // unused
-
-        for (CanonName const& methodName : meta.methods)
+        for (CanonName const& methodName : _classes.lookup(type)->methods)
         {
-            methods.insert(methodName);
+            if (seen.insert(methodName).second)
+            {
+                methods.push_back(methodName);
+            }
         }
     }
 
@@ -405,7 +319,7 @@ void GenEnv::leaveScope()
     _scopes.pop();
 }
 
-void GenEnv::declareLocal(String const& name, ValueType const& type)
+void GenEnv::declareLocal(Symbol const& name, ValueType const& type)
 {
     if (!_curMethod)
     {
@@ -415,29 +329,29 @@ void GenEnv::declareLocal(String const& name, ValueType const& type)
     _scopes.declLocal(name, type);
 }
 
-ValueType const& GenEnv::getLocalType(String const& name) const
+ValueType const& GenEnv::getLocalType(Symbol const& name) const
 {
     Decl const* decl = _scopes.lookup(name);
 
     if (!decl)
     {
-        throw std::logic_error("no local with name '" + name + "'");
+        throw std::logic_error("no local with name '" + name.str() + "'");
     }
 
     if (decl->declType != DeclType::local)
     {
-        throw std::logic_error("decl '" + name + "' is not a local");
+        throw std::logic_error("decl '" + name.str() + "' is not a local");
     }
 
     if (!decl->type.isValue())
     {
-        throw std::logic_error("decl '" + name + "' is not a value type");
+        throw std::logic_error("decl '" + name.str() + "' is not a value type");
     }
 
     return decl->type.value();
 }
 
-ValueType const* GenEnv::lookupLocalType(String const& name) const
+ValueType const* GenEnv::lookupLocalType(Symbol const& name) const
 {
     Decl const* decl = _scopes.lookup(name);
 
@@ -453,7 +367,7 @@ ValueType const* GenEnv::lookupLocalType(String const& name) const
 
     if (!decl->type.isValue())
     {
-        throw std::logic_error("decl '" + name + "' is not a value type");
+        throw std::logic_error("decl '" + name.str() + "' is not a value type");
     }
 
     return &decl->type.value();
@@ -461,49 +375,49 @@ ValueType const* GenEnv::lookupLocalType(String const& name) const
 
 GenEnv& GenEnv::operator<<(CodeTypeName const& x)
 {
-    write() << mangleTypeName(x.type);
+    write() << _names.typeName(x.type);
     return *this;
 }
 
 GenEnv& GenEnv::operator<<(CodeClassDecl const& x)
 {
-    write() << mangleClassDecl(x.type);
+    write() << _names.classDecl(x.type);
     return *this;
 }
 
 GenEnv& GenEnv::operator<<(CodeVarName const& x)
 {
-    write() << mangleVarName(x.value);
+    write() << _names.varName(x.value);
     return *this;
 }
 
 GenEnv& GenEnv::operator<<(CodeMemberName const& x)
 {
-    write() << mangleMemberName(x.value);
+    write() << _names.memberName(x.value);
     return *this;
 }
 
 GenEnv& GenEnv::operator<<(CodeMethodName const& x)
 {
-    write() << mangleMethodName(x.objectType, x.methodName);
+    write() << _names.methodName(x.objectType, x.methodName);
     return *this;
 }
 
 GenEnv& GenEnv::operator<<(CodeConsName const& x)
 {
-    write() << mangleConsName(x.consName);
+    write() << _names.consName(x.consName);
     return *this;
 }
 
 GenEnv& GenEnv::operator<<(CodeVTableName const& x)
 {
-    write() << mangleVTableName(x.classType);
+    write() << _names.vtableName(x.classType);
     return *this;
 }
 
 GenEnv& GenEnv::operator<<(CodeVTableMethodName const& x)
 {
-    write() << mangleVTableMethodName(x.methodName);
+    write() << _names.vtableMethodName(x.methodName);
     return *this;
 }
 
@@ -529,11 +443,11 @@ GenEnv& GenEnv::operator<<(CodeTabs const&)
 {
     if (_curMethod)
     {
-        write() << String(_methodTabs, '\t');
+        write().append(_methodTabs, '\t');
     }
     else
     {
-        write() << String(_classTabs, '\t');
+        write().append(_classTabs, '\t');
     }
     
     return *this;
@@ -589,34 +503,39 @@ GenEnv& GenEnv::operator<<(BlockPtr const& x)
     return *this;
 }
         
-void GenEnv::emitMemberVar(ValueType const& objectType, String const& memberName)
+void GenEnv::emitMemberVar(ValueType const& objectType, Symbol const& memberName)
 {
     Optional<MemberMeta> const member = _classes.lookupVar(objectType, memberName);
 
     if (!member)
     {
-        throw std::logic_error("no member var '" + memberName
-                + "' in '" + objectType.name() + "'");
+        throw std::logic_error("no member var '" + memberName.str()
+                + "' in '" + objectType.toString() + "'");
     }
     
-    *this << CodeLiteral("->");
+    if (_memberAccess.empty())
+    {
+        _memberAccess.push_back("->");
+    }
+
+    size_t const depth = size_t(member->depth);
 
-    for (int i = 1; i < member->depth; ++i)
+    while (_memberAccess.size() < depth)
     {
-        *this << CodeParent()
-              << CodeLiteral(".");
+        _memberAccess.push_back(_memberAccess.back() + "parent.");
     }
 
+    write() << _memberAccess[depth - 1];
     *this << CodeMemberName{memberName};
 }
 
-void GenEnv::emitObject(String const& objectName, String const& memberName)
+void GenEnv::emitObject(Symbol const& objectName, Symbol const& memberName)
 {
     Decl const* decl = _scopes.lookup(objectName);
 
     if (!decl)
     {
-        throw std::logic_error("no object '" + objectName + "' in scope");
+        throw std::logic_error("no object '" + objectName.str() + "' in scope");
     }
 
     *this << CodeVarName(objectName);
@@ -7,22 +7,17 @@
 #include "methodmeta.hpp"
 #include "typechecker_tools.hpp"
 #include "set.hpp"
-#include <sstream>
+#include "outbuffer.hpp"
+#include "mangletable.hpp"
 #include "optional.hpp"
 #include "vector.hpp"
 #include "type.hpp"
+#include "astarena.hpp"
 #include <memory>
 
 namespace dflat
 {
 
-// Have to forward declare to break include cycle.
-struct ASN;
-using ASNPtr = std::unique_ptr<ASN>;
-
-struct Block;
-using BlockPtr = std::unique_ptr<Block>;
-
 // Something like "struct T*"
 struct CodeTypeName     
 { 
@@ -85,17 +80,17 @@ struct CodeVTableMethodName
 
 struct CodeVarName
 { 
-    String value; 
-    CodeVarName(String _value)
-        : value(std::move(_value))
+    Symbol value; 
+    CodeVarName(Symbol _value)
+        : value(_value)
     {}
 };
 
 struct CodeMemberName
 { 
-    String value; 
-    CodeMemberName(String _value)
-        : value(std::move(_value))
+    Symbol value; 
+    CodeMemberName(Symbol _value)
+        : value(_value)
     {}
 };
 
@@ -127,19 +122,12 @@ struct CodeTabIn
 struct CodeTabOut
 {};
         
-String mangleTypeName(ValueType const&);
-String mangleClassDecl(ValueType const&);
-String mangleVarName(String const&);
-String mangleMemberName(String const&);
-String mangleMethodName(ValueType const& objectType, CanonName const& methodName);
-String mangleConsName(CanonName const&);
-String mangleVTableName(ValueType const&);
-String mangleVTableMethodName(CanonName const&);
-
 class GenEnv
 {
     public:
-        GenEnv(TypeEnv const&);
+        // Borrows typeEnv's class metadata, so typeEnv must outlive this.
+        GenEnv(TypeEnv const& typeEnv);
+        GenEnv(TypeEnv&&) = delete;
 
         GenEnv& operator<<(CodeTypeName const&);
         GenEnv& operator<<(CodeClassDecl const&);
@@ -158,9 +146,11 @@ class GenEnv
         GenEnv& operator<<(ASNPtr const&);
         GenEnv& operator<<(BlockPtr const&);
 
-        String prolog() const;
-        String epilog() const;
-        String concat() const;
+        void prolog(OutBuffer& out) const;
+        void epilog(OutBuffer& out) const;
+
+        // Moves what's been generated so far onto out: structs, then functions.
+        void flushTo(OutBuffer& out);
         
         void enterClass(ValueType const& classType);
         void leaveClass();
@@ -171,32 +161,37 @@ class GenEnv
         void leaveMethod();
         bool inMethod() const;
         MethodMeta const& curMethod() const;
-        MethodMeta const& getMethodMeta(ASN const*) const;
-        Set<CanonName> getClassMethods(ValueType const& classType) const;
-        Set<CanonName> getAllMethods() const;
+        // Own and inherited methods, each with the class that defines it.
+        Vector<MethodMeta> getClassMethods(ValueType const& classType) const;
+        Vector<CanonName> getAllMethods() const;
 
         void startBlock();
         void endBlock();
         void enterScope();
         void leaveScope();
-        void declareLocal(String const& name, ValueType const& type);
-        ValueType const& getLocalType(String const& name) const;
-        ValueType const* lookupLocalType(String const& name) const;
+        void declareLocal(Symbol const& name, ValueType const& type);
+        ValueType const& getLocalType(Symbol const& name) const;
+        ValueType const* lookupLocalType(Symbol const& name) const;
 
-        void emitMemberVar(ValueType const& objectType, String const& memberName);
-        void emitObject(String const& objectName, String const& memberName);
+        void emitMemberVar(ValueType const& objectType, Symbol const& memberName);
+        void emitObject(Symbol const& objectName, Symbol const& memberName);
 
     private:
-        std::stringstream& write();
+        OutBuffer& write();
+        void vtable(OutBuffer& out, ValueType const& classType) const;
         
-        std::stringstream _structDef;
-        std::stringstream _funcDef;
+        OutBuffer _structDef;
+        OutBuffer _funcDef;
         unsigned _methodTabs = 0;
         unsigned _classTabs = 0;
         ScopeMetaMan _scopes;
-        ClassMetaMan _classes;
-        MethodMetaMan _methods;
+        ClassMetaMan const& _classes;
+        MangleTable _names;
+        ClassMeta const* _curClass = nullptr;
         Optional<MethodMeta> _curMethod;
+
+        // "->", "->parent.", ... by member depth.
+        Vector<String> _memberAccess;
 };
 
 }
@@ -8,7 +8,7 @@ inline bool traceParse = false;
 inline bool traceTypeCheck = false;
 inline unsigned traceIndent = 2;
 
-inline String thisName("this");
-inline String consName("#cons"); // Must not be legal identifier.
+inline Symbol thisName("this");
+inline Symbol consName("#cons"); // Must not be legal identifier.
 
 } // namespace dflat::config
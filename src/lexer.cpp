@@ -1,23 +1,222 @@
 #include "lexer.hpp"
-#include "map.hpp"
+#include "lexerscan.hpp"
+#include "optional.hpp"
+#include <cstdint>
+#include <limits>
 
 namespace dflat
 {
     using namespace std;
 
+namespace
+{
+
+// Character classes, one byte of flags per char.
+enum CharClass : uint8_t
+{
+    ccSpace     = 1 << 0,
+    ccNameStart = 1 << 1,
+    ccNameChar  = 1 << 2,
+    ccDigit     = 1 << 3,
+    ccPunct1    = 1 << 4,   // Single-char punctuation
+    ccPunct2    = 1 << 5,   // May start two-char punctuation
+};
+
+struct CharInfo
+{
+    uint8_t cls;
+    TokType punct;  // Valid when cls has ccPunct1.
+};
+
+struct Punct
+{
+    char c1;
+    char c2;    // 0 for single-char.
+    TokType type;
+};
+
+constexpr Punct PUNCTS[]
+{
+    { '(', 0, tokLParen },
+    { ')', 0, tokRParen },
+    { ',', 0, tokComma },
+    { '{', 0, tokLBrace },
+    { '}', 0, tokRBrace },
+    { '=', 0, tokAssign },
+    { '+', 0, tokPlus },
+    { '-', 0, tokMinus },
+    { '*', 0, tokMult },
+    { '/', 0, tokDiv },
+    { '!', 0, tokNot },
+    { '.', 0, tokMember },
+    { ';', 0, tokSemi },
+    { '=', '=', tokEq },
+    { '!', '=', tokNotEq },
+    { '&', '&', tokAnd },
+    { '|', '|', tokOr },
+};
+
+struct CharTable
+{
+    CharInfo info[256];
+
+    constexpr CharTable()
+        : info()
+    {
+        for (int c = 0; c < 256; ++c)
+        {
+            uint8_t cls = 0;
+
+            if (c == ' ' || (c >= '\t' && c <= '\r'))
+            {
+                cls |= ccSpace;
+            }
+
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_')
+            {
+                cls |= ccNameStart | ccNameChar;
+            }
+
+            if (c >= '0' && c <= '9')
+            {
+                cls |= ccDigit | ccNameChar;
+            }
+
+            info[c] = CharInfo{ cls, tokEnd };
+        }
+
+        for (Punct const& p : PUNCTS)
+        {
+            CharInfo& i = info[static_cast<unsigned char>(p.c1)];
+
+            if (p.c2)
+            {
+                i.cls |= ccPunct2;
+            }
+            else
+            {
+                i.cls |= ccPunct1;
+                i.punct = p.type;
+            }
+        }
+    }
+
+    constexpr CharInfo const& operator[](char c) const
+    {
+        return info[static_cast<unsigned char>(c)];
+    }
+};
+
+constexpr CharTable CHARS;
+
+// To add a keyword, add it here; the hash below is rebuilt to fit.
+struct Keyword
+{
+    std::string_view text;
+    TokType type;
+};
+
+constexpr Keyword KEYWORDS[]
+{
+    { "if", tokIf },
+    { "else", tokElse },
+    { "while", tokWhile },
+    { "true", tokTrue },
+    { "false", tokFalse },
+    { "new", tokNew },
+    { "return", tokReturn },
+    { "this", tokThis },
+    { "class", tokClass },
+    { "extends", tokExtends },
+    { "cons", tokCons },
+    { "print", tokPrint },
+};
+
+constexpr size_t numKeywords = sizeof(KEYWORDS) / sizeof(KEYWORDS[0]);
+constexpr unsigned kwHashBits = 5;
+constexpr size_t kwSlots = size_t(1) << kwHashBits;
+
+static_assert(numKeywords < kwSlots, "Too many keywords for the hash table");
+
+// Multiplicative hash of length, first and last char. Never reads past len.
+constexpr uint32_t kwHash(std::string_view s, uint32_t seed)
+{
+    uint32_t const key = static_cast<uint32_t>(s.size()) << 16
+        | static_cast<uint32_t>(static_cast<unsigned char>(s[0])) << 8
+        | static_cast<uint32_t>(static_cast<unsigned char>(s[s.size() - 1]));
+    return (key * seed) >> (32 - kwHashBits);
+}
+
+constexpr bool kwSeedWorks(uint32_t seed)
+{
+    bool used[kwSlots] {};
+
+    for (Keyword const& kw : KEYWORDS)
+    {
+        uint32_t const h = kwHash(kw.text, seed);
+
+        if (used[h])
+        {
+            return false;
+        }
+
+        used[h] = true;
+    }
+
+    return true;
+}
+
+constexpr uint32_t findKwSeed()
+{
+    for (uint32_t seed = 0x9E3779B1u; seed != 0x9E3779B1u + 100000; seed += 2)
+    {
+        if (kwSeedWorks(seed))
+        {
+            return seed;
+        }
+    }
+
+    return 0;
+}
+
+constexpr uint32_t kwSeed = findKwSeed();
+static_assert(kwSeed != 0, "No perfect hash for the keyword set");
+
+// Slot -> keyword index + 1, 0 when empty.
+struct KeywordTable
+{
+    uint8_t slots[kwSlots];
+
+    constexpr KeywordTable()
+        : slots()
+    {
+        for (size_t i = 0; i < numKeywords; ++i)
+        {
+            slots[kwHash(KEYWORDS[i].text, kwSeed)] = static_cast<uint8_t>(i + 1);
+        }
+    }
+};
+
+constexpr KeywordTable KWTABLE;
+
+} // namespace
+
 class Lexer : private LexerCore
 {
     public:
-        Lexer(String const&);
-        Vector<TokenPtr> tokenize();
-        TokenPtr singleToken();
-        TokenPtr tryTokenizeName();
-        TokenPtr tryTokenizeNumber();
-        TokenPtr tryTokenizePunct();
+        Lexer(std::string_view);
+        TokenStream tokenize();
+        Optional<Token> pull();
+        Optional<Token> singleToken();
+        Optional<Token> tryTokenizeName();
+        Optional<Token> tryTokenizeNumber();
+        Optional<Token> tryTokenizePunct();
         void skipWhitespace();
-        TokenPtr lookupKeyword(String const&) const;
-        TokenPtr lookupPunct1(char c) const;
-        TokenPtr lookupPunct2(char c1, char c2) const;
+        size_t remaining() const;
+        Optional<TokType> lookupKeyword(std::string_view) const;
+        Optional<TokType> lookupPunct1(char c) const;
+        Optional<TokType> lookupPunct2(char c1, char c2) const;
+        Token makeToken(TokType, size_t start, int num = 0) const;
 };
 
 LexerException::LexerException(String msg) noexcept
@@ -25,232 +224,197 @@ LexerException::LexerException(String msg) noexcept
 {
 }
 
-Lexer::Lexer(String const& input)
+Lexer::Lexer(std::string_view input)
     : LexerCore(input)
 {
 }
 
-TokenPtr Lexer::tryTokenizeName()
+// Token spanning from start to the current position.
+Token Lexer::makeToken(TokType type, size_t start, int num) const
 {
-    char c = peek();
-    String var = "";
+    return Token{
+        type,
+        static_cast<uint32_t>(start),
+        static_cast<uint32_t>(_pos - start),
+        { num }
+        };
+}
 
-    if (!isalpha(c) && (c!='_'))
-    {
-        return nullptr;
-    }
+// Bytes left from the current position.
+size_t Lexer::remaining() const
+{
+    return _input.size() - _pos;
+}
+
+Optional<Token> Lexer::tryTokenizeName()
+{
+    const size_t start = _pos;
 
-    while (isalpha(c) || isdigit(c) || (c=='_'))
+    if (!(CHARS[peek()].cls & ccNameStart))
     {
-        var += get();
-        c = peek();
+        return nullopt;
     }
 
-    if(var.length() == 0)
-        return nullptr;
-    
-    TokenPtr ret = lookupKeyword(var);
+    _pos += scan::nameChars(_input.data() + _pos, remaining());
+    std::string_view const var = _input.substr(start, _pos - start);
 
-    if(ret == nullptr)
-        return make_unique<NameToken>(var);
+    Optional<TokType> kw = lookupKeyword(var);
+
+    if(!kw)
+    {
+        // Names are interned once here; later phases pass Symbols.
+        Token tok = makeToken(tokVar, start);
+        tok.sym = Symbol(var).id();
+        return tok;
+    }
 
-    return ret;
+    return makeToken(*kw, start);
 }
 
-TokenPtr Lexer::tryTokenizeNumber()
+Optional<Token> Lexer::tryTokenizeNumber()
 {
-    const size_t initialInputPos = _pos;
-    String digits = "";
+    // Find the digit run, then accumulate it; no temporary string.
+    const size_t start = _pos;
+    const size_t len = scan::digits(_input.data() + _pos, remaining());
+    const int max = std::numeric_limits<int>::max();
+    int value = 0;
 
-    char index = peek();
-    while ( index && isdigit(index) )
+    if (len == 0)
     {
-        digits += index;
-        next();
-        index = peek();
+        return nullopt;
     }
 
-    if ( digits.length() > 0)
-    {
-        return make_unique<NumberToken>(stoi(digits));
-    }
-    else
+    for (char const index : _input.substr(start, len))
     {
-        _pos = initialInputPos;
-        return nullptr;
+        int const digit = index - '0';
+
+        if (value > (max - digit) / 10)
+        {
+            throw LexerException("Number out of range at position: "
+                    + to_string(start));
+        }
+
+        value = value * 10 + digit;
     }
+
+    _pos += len;
+    return makeToken(tokNum, start, value);
 }
 
-TokenPtr Lexer::lookupKeyword(String const& name) const
+Optional<TokType> Lexer::lookupKeyword(std::string_view name) const
 {
-    static Map<String, TokType> const KWS
-    {
-        { "if", tokIf },
-        { "else", tokElse },
-        { "while", tokWhile },
-        { "true", tokTrue },
-        { "false", tokFalse },
-        { "new", tokNew },
-        { "return", tokReturn },
-        { "this", tokThis },
-        { "class", tokClass },
-        { "extends", tokExtends },
-        { "cons", tokCons },
-        { "print", tokPrint },
-    };
-
-    auto it = KWS.find(name);
-
-    if (it == KWS.end())
+    Keyword const* kw = nullptr;
+
+    if (uint8_t const slot = KWTABLE.slots[kwHash(name, kwSeed)])
     {
-        return nullptr;
+        kw = &KEYWORDS[slot - 1];
     }
 
-    switch (it->second)
+    if (!kw || kw->text != name)
     {
-        case tokIf:         return make_unique<IfToken>();
-        case tokElse:       return make_unique<ElseToken>();
-        case tokWhile:      return make_unique<WhileToken>();
-        case tokTrue:       return make_unique<TrueToken>();
-        case tokFalse:      return make_unique<FalseToken>();
-        case tokNew:        return make_unique<NewToken>();
-        case tokReturn:     return make_unique<ReturnToken>();
-        case tokThis:       return make_unique<ThisToken>();
-        case tokClass:      return make_unique<ClassToken>();
-        case tokExtends:    return make_unique<ExtendsToken>();
-        case tokCons:       return make_unique<ConsToken>();
-        case tokPrint:       return make_unique<PrintToken>();
-        default:            return nullptr;
+        return nullopt;
     }
+
+    return kw->type;
 }
 
-TokenPtr Lexer::lookupPunct1(char c) const
+Optional<TokType> Lexer::lookupPunct1(char c) const
 {
-    switch (c)
+    CharInfo const& info = CHARS[c];
+
+    if (!(info.cls & ccPunct1))
     {
-        case '(':   return make_unique<LeftParenToken>();
-        case ')':   return make_unique<RightParenToken>();
-        case ',':   return make_unique<CommaToken>();
-        case '{':   return make_unique<LeftBraceToken>();
-        case '}':   return make_unique<RightBraceToken>();
-        case '=':   return make_unique<AssignToken>();
-        case '+':   return make_unique<PlusToken>();
-        case '-':   return make_unique<MinusToken>();
-        case '*':   return make_unique<MultiplyToken>();
-        case '/':   return make_unique<DivisionToken>();
-        case '!':   return make_unique<NotToken>();
-        case '.':   return make_unique<MemberToken>();
-        case ';':   return make_unique<SemiToken>();
-        default:    return nullptr;
+        return nullopt;
     }
+
+    return info.punct;
 }
 
-TokenPtr Lexer::lookupPunct2(char c1, char c2) const
+Optional<TokType> Lexer::lookupPunct2(char c1, char c2) const
 {
-    switch (c2)
+    if (!(CHARS[c1].cls & ccPunct2))
     {
-        case '=':
-            switch (c1)
-            {
-                case '=': return make_unique<EqToken>();
-                case '!': return make_unique<NotEqToken>();
-                default: return nullptr;
-            }
-
-        case '&':
-            if (c1 == '&') return make_unique<AndToken>();
-            else return nullptr;
-
-        case '|':
-            if (c1 == '|') return make_unique<OrToken>();
-            else return nullptr;
+        return nullopt;
+    }
 
-        default:
-            return nullptr;
+    for (Punct const& p : PUNCTS)
+    {
+        if (p.c1 == c1 && p.c2 == c2)
+        {
+            return p.type;
+        }
     }
+
+    return nullopt;
 }
 
-TokenPtr Lexer::tryTokenizePunct()
+Optional<Token> Lexer::tryTokenizePunct()
 {
-    TokenPtr tok = nullptr;
+    const size_t start = _pos;
+    Optional<TokType> type;
 
-    if (tok = lookupPunct2(peek(), peek_ahead(1)))
+    if ((type = lookupPunct2(peek(), peek_ahead(1))))
     {
         next();
         next();
-        return tok;
+        return makeToken(*type, start);
     }
-    else if (tok = lookupPunct1(peek()))
+    else if ((type = lookupPunct1(peek())))
     {
         next();
-        return tok;
+        return makeToken(*type, start);
     }
     else
     {
-        return nullptr;
+        return nullopt;
     }
 }
 
 void Lexer::skipWhitespace()
 {
-    char c = peek();
-
-    while (isspace(c))
-    {
-        next();
-        c = peek();
-    }
+    _pos += scan::spaces(_input.data() + _pos, remaining());
 
     // Might have stopped due to a comment.
-    if (c == '/' && peek_ahead(1) == '/')
+    if (peek() == '/' && peek_ahead(1) == '/')
     {
         next();
         next();
-        c = peek();
-
-        while (c != '\n' && c != '\0')
-        {
-            next();
-            c = peek();
-        }
+        _pos += scan::untilNewline(_input.data() + _pos, remaining());
 
         // We may be on a new comment line.
         skipWhitespace();
     }
 }
 
-TokenPtr Lexer::singleToken(){
-    TokenPtr tok = nullptr;
-
+Optional<Token> Lexer::singleToken()
+{
     skipWhitespace();
-        
-    if ((tok = tryTokenizeName()))
+
+    // Dispatch on the class of the first char.
+    uint8_t const cls = CHARS[peek()].cls;
+
+    if (cls & ccNameStart)
     {
-        return tok;
-    } 
-    else if ((tok = tryTokenizeNumber()))
+        return tryTokenizeName();
+    }
+    else if (cls & ccDigit)
     {
-        return tok;
+        return tryTokenizeNumber();
     }
-    else if ((tok = tryTokenizePunct()))
+    else if (cls & (ccPunct1 | ccPunct2))
     {
-        return tok;
+        return tryTokenizePunct();
     }
-    
-    return nullptr;
+
+    return nullopt;
 }
 
-Vector<TokenPtr> Lexer::tokenize()
+// Next token, nullopt at the end of input, or throws on bad input.
+Optional<Token> Lexer::pull()
 {
-    Vector<TokenPtr> tokens;
-    TokenPtr current = nullptr;
+    Optional<Token> current = singleToken();
 
-    while((current = singleToken()))
-    {
-        tokens.push_back(move(current));
-    }
-
-    if(!at_end()) //If not end, but no valid token was returned above, error.
+    if(!current && !at_end()) //If not end, but no valid token was returned above, error.
     {
         String msg = "Illegal character: '";
         msg.push_back(peek());
@@ -258,13 +422,48 @@ Vector<TokenPtr> Lexer::tokenize()
         throw LexerException(msg);
     }
 
-    return tokens;
+    return current;
+}
+
+TokenStream Lexer::tokenize()
+{
+    Vector<Token> tokens;
+    Optional<Token> current;
+
+    while((current = pull()))
+    {
+        tokens.push_back(*current);
+    }
+
+    return TokenStream(move(tokens));
 }
 
-Vector<TokenPtr> tokenize(String const& input)
+TokenStream tokenize(std::string_view input)
 {
     Lexer lexer(input);
     return lexer.tokenize();
 }
 
+// Lexes a token each time the reader asks for one.
+class LexerProducer : public TokenProducer
+{
+    public:
+        LexerProducer(std::string_view input)
+            : _lexer(input)
+        {}
+
+        Optional<Token> nextToken() override
+        {
+            return _lexer.pull();
+        }
+
+    private:
+        Lexer _lexer;
+};
+
+std::unique_ptr<TokenProducer> streamTokens(std::string_view input)
+{
+    return std::make_unique<LexerProducer>(input);
+}
+
 } //namespace dflat
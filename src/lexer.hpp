@@ -4,11 +4,17 @@
 #include "lexercore.hpp"
 #include "vector.hpp"
 #include "token.hpp"
+#include "tokenwindow.hpp"
+#include <memory>
+#include <stdexcept>
 
 namespace dflat
 {
 
-Vector<TokenPtr> tokenize(String const&);
+TokenStream tokenize(std::string_view);
+
+// Lexes lazily, as the reader pulls tokens. The input must outlive it.
+std::unique_ptr<TokenProducer> streamTokens(std::string_view);
 
 class LexerException: public std::runtime_error
 {
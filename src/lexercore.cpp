@@ -3,7 +3,7 @@
 namespace dflat
 {
 
-LexerCore::LexerCore(String const& input)
+LexerCore::LexerCore(std::string_view input)
     : _input(input)
     , _pos(0)
 {
@@ -2,13 +2,15 @@
 #define LEXERCORE_HPP
 
 #include "string.hpp"
+#include <string_view>
 
 namespace dflat
 {
 
+// Reads from a view of the input; the caller keeps the text alive.
 struct LexerCore
 {
-    LexerCore(String const&);
+    LexerCore(std::string_view);
 
     bool at_end() const;
     char get();
@@ -17,7 +19,7 @@ struct LexerCore
     void next();
     size_t getPos() const;
 
-    String _input;
+    std::string_view _input;
     size_t _pos;
 };
 
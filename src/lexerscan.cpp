@@ -0,0 +1,207 @@
+#include "lexerscan.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DFLAT_SCAN_X86 1
+#include <immintrin.h>
+#else
+#define DFLAT_SCAN_X86 0
+#endif
+
+namespace dflat
+{
+namespace scan
+{
+
+namespace
+{
+
+// Character tests. Deliberately locale-free.
+inline bool isSpace(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool isNotNewline(char c)
+{
+    return c != '\n' && c != '\0';
+}
+
+inline bool isNameChar(char c)
+{
+    char const l = static_cast<char>(c | 0x20);
+    return (l >= 'a' && l <= 'z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+template <bool (*Pred)(char)>
+size_t scalarRun(char const* p, size_t n, size_t i = 0)
+{
+    while (i < n && Pred(p[i]))
+    {
+        ++i;
+    }
+
+    return i;
+}
+
+#if DFLAT_SCAN_X86
+
+// Each classifier returns a byte mask: 0xFF where the char is in the run.
+// Comparisons are signed, so bytes >= 0x80 are never in any run.
+
+// SSE2 (baseline on x86-64).
+
+inline __m128i sse2Space(__m128i c)
+{
+    __m128i const ctrl = _mm_and_si128(
+        _mm_cmpgt_epi8(c, _mm_set1_epi8('\t' - 1)),
+        _mm_cmplt_epi8(c, _mm_set1_epi8('\r' + 1)));
+    return _mm_or_si128(ctrl, _mm_cmpeq_epi8(c, _mm_set1_epi8(' ')));
+}
+
+inline __m128i sse2NotNewline(__m128i c)
+{
+    __m128i const stop = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n')),
+                                      _mm_cmpeq_epi8(c, _mm_setzero_si128()));
+    return _mm_xor_si128(stop, _mm_set1_epi8(-1));
+}
+
+inline __m128i sse2Digit(__m128i c)
+{
+    return _mm_and_si128(
+        _mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+        _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+}
+
+inline __m128i sse2NameChar(__m128i c)
+{
+    __m128i const l = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    __m128i const alpha = _mm_and_si128(
+        _mm_cmpgt_epi8(l, _mm_set1_epi8('a' - 1)),
+        _mm_cmplt_epi8(l, _mm_set1_epi8('z' + 1)));
+    __m128i const under = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+    return _mm_or_si128(_mm_or_si128(alpha, under), sse2Digit(c));
+}
+
+template <__m128i (*Classify)(__m128i), bool (*Pred)(char)>
+size_t sse2Run(char const* p, size_t n)
+{
+    size_t i = 0;
+
+    while (i + 16 <= n)
+    {
+        __m128i const c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+        unsigned const in = static_cast<unsigned>(_mm_movemask_epi8(Classify(c)));
+
+        if (in != 0xFFFFu)
+        {
+            return i + static_cast<size_t>(__builtin_ctz(~in));
+        }
+
+        i += 16;
+    }
+
+    return scalarRun<Pred>(p, n, i);
+}
+
+#endif // DFLAT_SCAN_X86
+
+using RunFn = size_t (*)(char const*, size_t);
+
+struct Scanners
+{
+    RunFn spaces;
+    RunFn untilNewline;
+    RunFn nameChars;
+    RunFn digits;
+};
+
+Scanners const scalarScanners
+{
+    [](char const* p, size_t n) { return scalarRun<isSpace>(p, n); },
+    [](char const* p, size_t n) { return scalarRun<isNotNewline>(p, n); },
+    [](char const* p, size_t n) { return scalarRun<isNameChar>(p, n); },
+    [](char const* p, size_t n) { return scalarRun<isDigit>(p, n); },
+};
+
+#if DFLAT_SCAN_X86
+Scanners const sse2Scanners
+{
+    sse2Run<sse2Space, isSpace>,
+    sse2Run<sse2NotNewline, isNotNewline>,
+    sse2Run<sse2NameChar, isNameChar>,
+    sse2Run<sse2Digit, isDigit>,
+};
+#endif
+
+Scanners const& scannersFor(Level l)
+{
+    switch (l)
+    {
+#if DFLAT_SCAN_X86
+        case Level::sse2:   return sse2Scanners;
+#else
+        case Level::sse2:
+#endif
+        case Level::scalar: return scalarScanners;
+    }
+
+    return scalarScanners;
+}
+
+Level s_level = bestLevel();
+Scanners const* s_scanners = &scannersFor(s_level);
+
+} // namespace
+
+Level bestLevel()
+{
+#if DFLAT_SCAN_X86
+    return Level::sse2;
+#else
+    return Level::scalar;
+#endif
+}
+
+Level level()
+{
+    return s_level;
+}
+
+void setLevel(Level l)
+{
+    if (static_cast<int>(l) > static_cast<int>(bestLevel()))
+    {
+        l = bestLevel();
+    }
+
+    s_level = l;
+    s_scanners = &scannersFor(l);
+}
+
+size_t spaces(char const* p, size_t n)
+{
+    return s_scanners->spaces(p, n);
+}
+
+size_t untilNewline(char const* p, size_t n)
+{
+    return s_scanners->untilNewline(p, n);
+}
+
+size_t nameChars(char const* p, size_t n)
+{
+    return s_scanners->nameChars(p, n);
+}
+
+size_t digits(char const* p, size_t n)
+{
+    return s_scanners->digits(p, n);
+}
+
+} // namespace scan
+} // namespace dflat
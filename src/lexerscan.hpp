@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+namespace dflat
+{
+
+// Run scanners for the lexer's hot loops.
+// Each returns how many leading chars of [p, p+n) belong to the run.
+// Vectorized with SSE2 on x86-64, which every such CPU has.
+// Identifier and whitespace runs are short, so wider vectors don't pay.
+namespace scan
+{
+
+enum class Level { scalar, sse2 };
+
+size_t spaces(char const* p, size_t n);        // C-locale isspace
+size_t untilNewline(char const* p, size_t n);  // Comment bodies; stops at '\n' or NUL
+size_t nameChars(char const* p, size_t n);     // [A-Za-z0-9_]
+size_t digits(char const* p, size_t n);        // [0-9]
+
+// Best level this build supports.
+Level bestLevel();
+
+// Level in use. Defaults to bestLevel(); lowering it is for benchmarks.
+Level level();
+void setLevel(Level);
+
+} // namespace scan
+
+} // namespace dflat
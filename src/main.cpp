@@ -1,8 +1,8 @@
 #include <iostream>
 #include <string>
-#include <fstream>
-#include <sstream>
+#include <unistd.h>
 
+#include "sourcefile.hpp"
 #include "lexer.hpp"
 #include "parser.hpp"
 #include "typechecker.hpp"
@@ -15,45 +15,38 @@ using namespace dflat;
 int main(int argc, char* argv[])
 {
     string fileName;
+    string outName;
 
     if(argc == 2)
     {
         //read in a file name from command line:
         fileName = argv[1];
     }
-    else
+    else if(argc == 4 && string(argv[2]) == "-o")
     {
-        cerr << "Usage: dflat SOURCEFILE" << endl;
-        return 1;
-    }
-
-    ifstream file(fileName);
-    stringstream buffer;
-    string fileContents;
-
-    if(file.is_open())
-    {
-        buffer << file.rdbuf();
-        fileContents = buffer.str();
+        //and where to write the C, instead of stdout:
+        fileName = argv[1];
+        outName = argv[3];
     }
     else
     {
-        cerr << "Error: File not found!\n";
+        cerr << "Usage: dflat SOURCEFILE [-o OUTFILE] (- for stdin)" << endl;
         return 1;
     }
 
     try
     {
-        //Take file contents and run compiler:
-
-        //Run Lexer:
-        Vector<TokenPtr> tokens = tokenize(fileContents);
-        //for (TokenPtr const& token : tokens)
-            //cout << token->toString() << endl;
-
-        //Run Parser:
+        //Run Lexer and Parser together over the mapped file (or stdin).
+        //The parser pulls tokens as it goes, keeping only its lookahead.
+        //ASTs don't refer back to the text, so it's released after.
+        //Nodes live in the arena until code generation is done.
         //config::traceParse = true;
-        Vector<ASNPtr> program = parse(tokens);
+        ASTArena arena;
+        Vector<ASNPtr> program;
+        {
+            SourceFile file(fileName);
+            program = parse(streamTokens(file.text()), &arena);
+        }
         //for (ASNPtr const& decl : program)
            //cout << decl->toString() << endl << endl;
 
@@ -62,8 +55,27 @@ int main(int argc, char* argv[])
         TypeEnv typeEnv = typeCheck(program);
 
         // Run CodeGenerator:
-        String output = generateCode(program, typeEnv);
-        std::cout << output << endl;
+        //Output is written with writev as it's generated, a few chunks
+        //at a time, starting with the prolog.
+        Optional<OutFile> outFile;
+
+        if (!outName.empty())
+        {
+            outFile.emplace(outName);
+        }
+
+        OutBuffer output;
+        output.streamTo(outFile ? outFile->fd() : STDOUT_FILENO);
+        generateCode(program, typeEnv, output);
+        output << "\n";
+        output.flush();
+
+        if (outFile)
+        {
+            outFile->close();
+        }
+
+        arena.release();
         return 0;
     }
     catch(std::runtime_error& e)
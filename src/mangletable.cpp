@@ -0,0 +1,202 @@
+#include "mangletable.hpp"
+#include "config.hpp"
+
+namespace dflat
+{
+
+String mangleTypeName(ValueType const& typeName)
+{
+    if (isBuiltinType(typeName))
+    {
+        return translateBuiltinType(typeName);
+    }
+    else
+    {
+        return "struct df_" + typeName.toString() + "*";
+    }
+}
+
+String mangleClassDecl(ValueType const& x)
+{
+    return "df_" + x.toString();
+}
+
+String mangleVarName(Symbol const& x)
+{
+    return "df_" + x.str();
+}
+
+String mangleMemberName(Symbol const& x)
+{
+    return "df_" + x.str();
+}
+
+static
+void appendArgs(String& s, Vector<ValueType> const& args)
+{
+    if (args.empty())
+    {
+        s += '_';
+    }
+
+    for (ValueType const& arg : args)
+    {
+        s += '_';
+        s += arg.name().str();
+    }
+}
+
+String mangleMethodName(ValueType const& objectType,
+        CanonName const& methodName)
+{
+    String s = "dfm_";
+    s += objectType.name().str();
+    s += '_';
+    s += methodName.baseName().str();
+    appendArgs(s, methodName.type().args());
+    return s;
+}
+
+String mangleConsName(CanonName const& consName)
+{
+    String s = "dfc_";
+    s += consName.type().ret().name().str();
+    appendArgs(s, consName.type().args());
+    return s;
+}
+
+String mangleVTableName(ValueType const& classType)
+{
+    return "dfv_" + classType.toString();
+}
+
+String mangleVTableMethodName(CanonName const& methodName)
+{
+    String s = "dfvm_";
+    s += methodName.baseName().str();
+    appendArgs(s, methodName.type().args());
+    return s;
+}
+
+MangleTable::MangleTable(ClassMetaMan const& classes)
+{
+    for (auto const& [type, meta] : classes.allClasses())
+    {
+        classNames(type);
+
+        for (auto const& [name, member] : meta.vars)
+        {
+            if (member.depth == 1)
+            {
+                memberName(name);
+            }
+        }
+
+        for (auto const& [name, member] : meta.methodMembers)
+        {
+            if (member.depth != 1)
+            {
+                continue;
+            }
+
+            if (name.baseName() == config::consName)
+            {
+                consName(name);
+            }
+            else
+            {
+                methodName(type, name);
+                vtableMethodName(name);
+            }
+        }
+    }
+}
+
+MangleTable::ClassNames& MangleTable::classNames(ValueType const& type) const
+{
+    auto it = _classes.find(type);
+
+    if (it == _classes.end())
+    {
+        ClassNames names{ mangleTypeName(type), mangleClassDecl(type),
+            mangleVTableName(type), {}, {} };
+        it = _classes.insert({ type, std::move(names) }).first;
+    }
+
+    return it->second;
+}
+
+String const& MangleTable::typeName(ValueType const& type) const
+{
+    return classNames(type).typeName;
+}
+
+String const& MangleTable::classDecl(ValueType const& type) const
+{
+    return classNames(type).classDecl;
+}
+
+String const& MangleTable::vtableName(ValueType const& type) const
+{
+    return classNames(type).vtableName;
+}
+
+// Locals and members mangle the same way.
+String const& MangleTable::varName(Symbol const& name) const
+{
+    auto it = _vars.find(name);
+
+    if (it == _vars.end())
+    {
+        it = _vars.insert({ name, mangleVarName(name) }).first;
+    }
+
+    return it->second;
+}
+
+String const& MangleTable::memberName(Symbol const& name) const
+{
+    return varName(name);
+}
+
+String const& MangleTable::methodName(ValueType const& objectType,
+        CanonName const& name) const
+{
+    Map<CanonName, String>& methods = classNames(objectType).methods;
+    auto it = methods.find(name);
+
+    if (it == methods.end())
+    {
+        it = methods.insert({ name, mangleMethodName(objectType, name) }).first;
+    }
+
+    return it->second;
+}
+
+// By class too: canonical names leave out the return type.
+String const& MangleTable::consName(CanonName const& name) const
+{
+    Map<CanonName, String>& conses = classNames(name.type().ret()).conses;
+    auto it = conses.find(name);
+
+    if (it == conses.end())
+    {
+        it = conses.insert({ name, mangleConsName(name) }).first;
+    }
+
+    return it->second;
+}
+
+String const& MangleTable::vtableMethodName(CanonName const& name) const
+{
+    auto it = _vtableMethods.find(name);
+
+    if (it == _vtableMethods.end())
+    {
+        it = _vtableMethods.insert({ name, mangleVTableMethodName(name) }).first;
+    }
+
+    return it->second;
+}
+
+} // namespace dflat
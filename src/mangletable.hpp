@@ -0,0 +1,57 @@
+#pragma once
+
+#include "string.hpp"
+#include "map.hpp"
+#include "type.hpp"
+#include "canonname.hpp"
+#include "classmeta.hpp"
+
+namespace dflat
+{
+
+String mangleTypeName(ValueType const&);
+String mangleClassDecl(ValueType const&);
+String mangleVarName(Symbol const&);
+String mangleMemberName(Symbol const&);
+String mangleMethodName(ValueType const& objectType, CanonName const& methodName);
+String mangleConsName(CanonName const&);
+String mangleVTableName(ValueType const&);
+String mangleVTableMethodName(CanonName const&);
+
+// Mangled C names, each built once and then only copied out.
+// Every declared class, member and method is mangled up front from the
+//  finished class metadata. Anything else (builtin types, locals) is
+//  mangled on first use and kept.
+class MangleTable
+{
+    public:
+        MangleTable(ClassMetaMan const&);
+
+        String const& typeName(ValueType const&) const;
+        String const& classDecl(ValueType const&) const;
+        String const& vtableName(ValueType const&) const;
+        String const& varName(Symbol const&) const;
+        String const& memberName(Symbol const&) const;
+        String const& methodName(ValueType const& objectType, CanonName const&) const;
+        String const& consName(CanonName const&) const;
+        String const& vtableMethodName(CanonName const&) const;
+
+    private:
+        struct ClassNames
+        {
+            String typeName;
+            String classDecl;
+            String vtableName;
+            Map<CanonName, String> methods;
+            Map<CanonName, String> conses;
+        };
+
+        ClassNames& classNames(ValueType const&) const;
+
+        // Entries never move, so references stay good.
+        mutable Map<ValueType, ClassNames> _classes;
+        mutable Map<Symbol, String> _vars;
+        mutable Map<CanonName, String> _vtableMethods;
+};
+
+} // namespace dflat
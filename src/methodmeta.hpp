@@ -1,7 +1,6 @@
 #pragma once
 
 #include "string.hpp"
-#include "map.hpp"
 #include "canonname.hpp"
 
 namespace dflat
@@ -9,22 +8,10 @@ namespace dflat
 
 // This is metadata for method calls, not methods in general.
 
-struct ASN;
-
 struct MethodMeta
 {
     ValueType thisType;
     CanonName methodName;
 };
 
-class MethodMetaMan
-{
-    public:
-        MethodMeta const* lookupMeta(ASN const*) const;
-        void setMeta(ASN const*, MethodMeta);
-
-    private:
-        Map<ASN const*, MethodMeta> _canonNames;
-};
-
 } // namespace dflat
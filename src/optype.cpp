@@ -0,0 +1,38 @@
+#include "optype.hpp"
+#include <cstdlib>
+
+namespace dflat
+{
+
+String opString(OpType op)
+{
+    switch(op)
+    {
+        case opPlus:        return "+";
+        case opMinus:       return "-";
+        case opDiv:         return "/";
+        case opMult:        return "*";
+        case opNot:         return "!";
+        case opAnd:         return "&&";
+        case opOr:          return "||";
+        case opLogEq:       return "==";
+        case opLogNotEq:    return "!=";
+    }
+
+    std::abort(); // Unhandled op.
+}
+
+Symbol const& opSymbol(OpType op)
+{
+    // In OpType order.
+    static Symbol const symbols[] =
+    {
+        opString(opPlus), opString(opMinus), opString(opMult),
+        opString(opDiv), opString(opNot), opString(opAnd),
+        opString(opOr), opString(opLogEq), opString(opLogNotEq)
+    };
+
+    return symbols[op];
+}
+
+} // namespace dflat
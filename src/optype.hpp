@@ -0,0 +1,18 @@
+#pragma once
+
+#include "string.hpp"
+#include "symbol.hpp"
+#include <cstddef>
+
+namespace dflat
+{
+
+enum OpType { opPlus, opMinus, opMult, opDiv, opNot, opAnd, opOr,
+                opLogEq, opLogNotEq };
+
+size_t const opCount = opLogNotEq + 1;
+
+String opString(OpType);
+Symbol const& opSymbol(OpType); // Interned opString
+
+} // namespace dflat
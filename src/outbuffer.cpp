@@ -0,0 +1,210 @@
+#include "outbuffer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace dflat
+{
+
+OutputException::OutputException(String msg) noexcept
+    : std::runtime_error("Error: " + std::move(msg))
+{}
+
+// Last chunk, or a new one if it's full.
+OutBuffer::Chunk& OutBuffer::room()
+{
+    if (_chunks.empty() || _chunks.back().size == _chunks.back().capacity)
+    {
+        if (_streamFd >= 0 && _size >= streamSize)
+        {
+            flush();
+        }
+        else
+        {
+            _chunks.push_back({ std::make_unique<char[]>(chunkSize), 0, chunkSize });
+        }
+    }
+
+    return _chunks.back();
+}
+
+void OutBuffer::append(char const* data, size_t size)
+{
+    while (size > 0)
+    {
+        Chunk& chunk = room();
+        size_t const n = std::min(size, chunk.capacity - chunk.size);
+
+        std::memcpy(chunk.data.get() + chunk.size, data, n);
+        chunk.size += n;
+        _size += n;
+        data += n;
+        size -= n;
+    }
+}
+
+void OutBuffer::append(size_t count, char c)
+{
+    while (count > 0)
+    {
+        Chunk& chunk = room();
+        size_t const n = std::min(count, chunk.capacity - chunk.size);
+
+        std::memset(chunk.data.get() + chunk.size, c, n);
+        chunk.size += n;
+        _size += n;
+        count -= n;
+    }
+}
+
+void OutBuffer::splice(OutBuffer&& other)
+{
+    for (Chunk& chunk : other._chunks)
+    {
+        // Mostly empty chunks are copied instead, and kept to reuse.
+        if (chunk.size < chunk.capacity / 2)
+        {
+            append(chunk.data.get(), chunk.size);
+            chunk.size = 0;
+        }
+        else
+        {
+            _size += chunk.size;
+            _chunks.push_back(std::move(chunk));
+        }
+    }
+
+    auto const moved = [](Chunk const& chunk) { return !chunk.data; };
+    auto const end = std::remove_if(other._chunks.begin(), other._chunks.end(), moved);
+    other._chunks.erase(std::min(end, other._chunks.begin() + 1), other._chunks.end());
+    other._size = 0;
+
+    if (_streamFd >= 0 && _size >= streamSize)
+    {
+        flush();
+    }
+}
+
+String OutBuffer::str() const
+{
+    String s;
+    s.reserve(_size);
+
+    for (Chunk const& chunk : _chunks)
+    {
+        s.append(chunk.data.get(), chunk.size);
+    }
+
+    return s;
+}
+
+void OutBuffer::writeTo(int fd) const
+{
+    Vector<iovec> iov;
+    iov.reserve(_chunks.size());
+
+    for (Chunk const& chunk : _chunks)
+    {
+        if (chunk.size > 0)
+        {
+            iov.push_back({ chunk.data.get(), chunk.size });
+        }
+    }
+
+    size_t next = 0;
+
+    while (next < iov.size())
+    {
+        int const count = static_cast<int>(std::min(iov.size() - next, size_t(IOV_MAX)));
+        ssize_t const written = ::writev(fd, &iov[next], count);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw OutputException(String("Cannot write output: ") + std::strerror(errno));
+        }
+
+        // Skip what went out, which may end partway into a chunk.
+        size_t left = static_cast<size_t>(written);
+
+        while (next < iov.size() && left >= iov[next].iov_len)
+        {
+            left -= iov[next].iov_len;
+            ++next;
+        }
+
+        if (left > 0)
+        {
+            iov[next].iov_base = static_cast<char*>(iov[next].iov_base) + left;
+            iov[next].iov_len -= left;
+        }
+    }
+}
+
+void OutBuffer::writeTo(FilePath const& path) const
+{
+    OutFile file(path);
+    writeTo(file.fd());
+    file.close();
+}
+
+void OutBuffer::streamTo(int fd)
+{
+    _streamFd = fd;
+}
+
+void OutBuffer::flush()
+{
+    if (_streamFd < 0 || _chunks.empty())
+    {
+        return;
+    }
+
+    writeTo(_streamFd);
+
+    // Keep one chunk to fill again.
+    _chunks.resize(1);
+    _chunks.front().size = 0;
+    _size = 0;
+}
+
+OutFile::OutFile(FilePath const& path)
+    : _path(path)
+    , _fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644))
+{
+    if (_fd < 0)
+    {
+        throw OutputException("Cannot open '" + path + "': "
+                + std::strerror(errno));
+    }
+}
+
+OutFile::~OutFile()
+{
+    if (_fd >= 0)
+    {
+        ::close(_fd);
+    }
+}
+
+void OutFile::close()
+{
+    int const fd = _fd;
+    _fd = -1;
+
+    if (fd >= 0 && ::close(fd) != 0)
+    {
+        throw OutputException("Cannot write '" + _path + "': "
+                + std::strerror(errno));
+    }
+}
+
+} // namespace dflat
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "string.hpp"
+#include "vector.hpp"
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+
+namespace dflat
+{
+
+// Generated output as a list of large chunks.
+// Appends fill the last chunk and start a new one when it's full, so
+//  nothing already written is ever copied again.
+// The chunks go to a file descriptor with writev, never flattened:
+//  all at once with writeTo, or a few at a time once streamTo is set.
+class OutBuffer
+{
+    public:
+        OutBuffer() = default;
+        OutBuffer(OutBuffer&&) = default;
+        OutBuffer& operator=(OutBuffer&&) = default;
+
+        void append(char const* data, size_t size);
+        void append(size_t count, char c);
+
+        OutBuffer& operator<<(std::string_view s)
+        {
+            append(s.data(), s.size());
+            return *this;
+        }
+
+        // Moves other's text onto the end; other is left empty.
+        // Full chunks change hands, and only small pieces are copied.
+        void splice(OutBuffer&& other);
+
+        size_t size() const { return _size; }
+
+        // One string of the whole output, for tests and small programs.
+        String str() const;
+
+        void writeTo(int fd) const;
+        void writeTo(FilePath const&) const;
+
+        // From now on, writes everything held to fd whenever a few
+        //  chunks have filled. The caller keeps fd open and calls flush
+        //  to write the rest.
+        void streamTo(int fd);
+        void flush();
+
+    private:
+        struct Chunk
+        {
+            std::unique_ptr<char[]> data;
+            size_t size;
+            size_t capacity;
+        };
+
+        static constexpr size_t chunkSize = 256 * 1024;
+        static constexpr size_t streamSize = 4 * chunkSize;
+
+        Chunk& room();
+
+        Vector<Chunk> _chunks;
+        size_t _size = 0;
+        int _streamFd = -1;
+};
+
+// An output file, truncated on open and closed when done.
+class OutFile
+{
+    public:
+        explicit OutFile(FilePath const&);
+        ~OutFile();
+
+        OutFile(OutFile const&) = delete;
+        OutFile& operator=(OutFile const&) = delete;
+
+        int fd() const { return _fd; }
+
+        // Like the destructor, but reports errors.
+        void close();
+
+    private:
+        FilePath _path;
+        int _fd;
+};
+
+class OutputException : public std::runtime_error
+{
+    public:
+        OutputException(String msg) noexcept;
+};
+
+} // namespace dflat
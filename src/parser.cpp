@@ -7,17 +7,31 @@ namespace dflat
 
 using namespace std;
 
-#define TRACE _tracer.push(__func__ + String(" ") + cur()->toString() + " (" + to_string(_tokenPos) + ")")
-#define SUCCESS _tracer.pop(traceSuccess)
-#define FAILURE _tracer.pop(traceFailure)
+// Tracing costs one branch per rule when off, and trace names are only
+//  built when on. Release (NDEBUG) builds compile it out.
+#ifdef NDEBUG
+#define TRACING false
+#else
+#define TRACING config::traceParse
+#endif
+
+#define TRACE do { if (TRACING) _tracer.push(__func__ + String(" ") + to_string(cur()) + " (" + to_string(_tokenPos) + ")"); } while (0)
+#define SUCCESS do { if (TRACING) _tracer.pop(traceSuccess); } while (0)
+#define FAILURE do { if (TRACING) _tracer.pop(traceFailure); } while (0)
 
 #define ENABLE_ROLLBACK auto rollbacker = Rollbacker(*this, _tokenPos)
 #define CANCEL_ROLLBACK rollbacker.disable()
 
 
-Vector<ASNPtr> parse(Vector<TokenPtr> const& tokens)
+Vector<ASNPtr> parse(TokenStream tokens, ASTArena* arena)
 {
-    Parser p(tokens);
+    Parser p(std::move(tokens), true, arena);
+    return p.parseProgram();
+}
+
+Vector<ASNPtr> parse(std::unique_ptr<TokenProducer> tokens, ASTArena* arena)
+{
+    Parser p(std::move(tokens), true, arena);
     return p.parseProgram();
 }
 
@@ -28,16 +42,11 @@ ParserException::ParserException(String msg) noexcept
 
 /**
  * @brief Returns the current token or end of program token.
- * @return TokenPtr
+ * @return Token
  */
-TokenPtr const& Parser::cur() const
+Token const& Parser::cur()
 {
-    if (_tokenPos >= _tokens.size())
-    {
-        return _end;
-    }
-
-    return _tokens[_tokenPos];
+    return _tokens.at(_tokenPos);
 }
 
 /**
@@ -45,12 +54,40 @@ TokenPtr const& Parser::cur() const
  */
 void Parser::next()
 {
-    if (_tokenPos >= _tokens.size())
+    if (_tokens.atEnd(_tokenPos))
     {
         return;
     }
 
     ++_tokenPos;
+
+    // Keep only what a live Rollbacker could return to.
+    _tokens.release(_marks.empty() ? _tokenPos : _marks.front());
+}
+
+// Type of the token n places ahead of the current one.
+TokType Parser::lookahead(size_t n)
+{
+    return _tokens.at(_tokenPos + n).type;
+}
+
+// Tokens in the variable starting here: 1 for x or this,
+//  3 for x.y or this.y, 0 if there's no variable.
+size_t Parser::variableLength()
+{
+    TokType const first = cur().type;
+
+    if (first != tokVar && first != tokThis)
+    {
+        return 0;
+    }
+
+    if (lookahead(1) != tokMember)
+    {
+        return 1;
+    }
+
+    return lookahead(2) == tokVar ? 3 : 0;
 }
 
 // Matches the current token against a given token type.
@@ -58,19 +95,19 @@ void Parser::next()
 //              and the current token advances.
 //  On nullopt, the present function returns early with nullptr:
 #define MATCH(var, type) \
-    type const* var##__ = match<type>(); \
+    Optional<Token> var##__ = match<type>(); \
     if (!var##__) { FAILURE; return {}; } \
-    type const& var = *var##__ \
+    Token const var = *var##__ \
     /*end MATCH*/
 
 //Same as MATCH, but instead of returning a nullptr, throws an exception
 //expected is a string saying what should be matched:
 #define MUST_MATCH(var, type, expected) \
-    type const* var##__ = match<type>(); \
+    Optional<Token> var##__ = match<type>(); \
     if (!var##__) { FAILURE; \
         throw ParserException("Expected " + String(expected) \
             + " at position: " + to_string(_tokenPos)); } \
-    type const& var = *var##__ \
+    Token const var = *var##__ \
     /*end MUST_MATCH*/
 
 // Matches the current token but doesn't store it in a var:
@@ -120,14 +157,14 @@ decltype(auto) deref(T& t)
     decltype(auto) var = deref(var##__)
     /*end MUST_PARSE*/
 
-// Parses a NameToken as a string.
-Optional<String> Parser::parseName()
+// Parses a NameToken as its interned Symbol.
+Optional<Symbol> Parser::parseName()
 {
     TRACE;
-    if (NameToken const* tok = match<NameToken>())
+    if (Optional<Token> tok = match<NameToken>())
     {
         SUCCESS;
-        return tok->name;
+        return tok->symbol();
     }
     else
     {
@@ -139,7 +176,7 @@ Optional<String> Parser::parseName()
 Optional<OpType> Parser::parseUnaryOp()
 {
     TRACE;
-    switch (cur()->getType())
+    switch (cur().type)
     {
         case tokNot:    SUCCESS; next(); return opNot;
         case tokMinus:  SUCCESS; next(); return opMinus;
@@ -147,41 +184,6 @@ Optional<OpType> Parser::parseUnaryOp()
     }
 }
 
-Optional<OpType> Parser::parseMultiveOp()
-{
-    TRACE;
-    switch (cur()->getType())
-    {
-        case tokMult:   SUCCESS; next(); return opMult;
-        case tokDiv:    SUCCESS; next(); return opDiv;
-        default:        FAILURE; return nullopt;
-    }
-}
-
-Optional<OpType> Parser::parseAdditiveOp()
-{
-    TRACE;
-    switch (cur()->getType())
-    {
-        case tokPlus:   SUCCESS; next(); return opPlus;
-        case tokMinus:  SUCCESS; next(); return opMinus;
-        default:        FAILURE; return nullopt;
-    }
-}
-
-Optional<OpType> Parser::parseLogicalOp()
-{
-    TRACE;
-    switch (cur()->getType())
-    {
-        case tokAnd:    SUCCESS; next(); return opAnd;
-        case tokOr:     SUCCESS; next(); return opOr;
-        case tokEq:     SUCCESS; next(); return opLogEq;
-        case tokNotEq:  SUCCESS; next(); return opLogNotEq;
-        default:        FAILURE; return nullopt;
-    }
-}
-
 // TODO: chained . operator doesn't work. a.b.c.
 Optional<Variable> Parser::parseVariable()
 {
@@ -239,11 +241,11 @@ ASNPtr Parser::parseVariableExp()
     SUCCESS;
     if (var.object)
     {
-        return make_unique<VariableExp>(*var.object, var.variable);
+        return makeNode<VariableExp>(_arena, *var.object, var.variable);
     }
     else
     {
-        return make_unique<VariableExp>(var.variable);
+        return makeNode<VariableExp>(_arena, var.variable);
     }
 }
 
@@ -263,7 +265,7 @@ ASNPtr Parser::parseNumber()
     TRACE;
     MATCH(num, NumberToken);
     SUCCESS;
-    return make_unique<NumberExp>(num.num);
+    return makeNode<NumberExp>(_arena, num.num);
 }
 
 ASNPtr Parser::parseBoolTrue()
@@ -271,7 +273,7 @@ ASNPtr Parser::parseBoolTrue()
     TRACE;
     MATCH_(TrueToken);
     SUCCESS;
-    return make_unique<BoolExp>(true);
+    return makeNode<BoolExp>(_arena, true);
 }
 
 ASNPtr Parser::parseBoolFalse()
@@ -279,7 +281,7 @@ ASNPtr Parser::parseBoolFalse()
     TRACE;
     MATCH_(FalseToken);
     SUCCESS;
-    return make_unique<BoolExp>(false);
+    return makeNode<BoolExp>(_arena, false);
 }
 
 ASNPtr Parser::parseUnary()
@@ -293,7 +295,7 @@ ASNPtr Parser::parseUnary()
 
     CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<UnopExp>(move(prim), op);
+    return makeNode<UnopExp>(_arena, move(prim), op);
 }
 
 ASNPtr Parser::parseMethodExp()
@@ -302,7 +304,7 @@ ASNPtr Parser::parseMethodExp()
     TRACE;
     ENABLE_ROLLBACK;
 
-    Vector<ASNPtr> exps;
+    ASNList exps = makeList(_arena);
     ASNPtr temp;
 
     PARSE(method, parseVariable());
@@ -321,7 +323,7 @@ ASNPtr Parser::parseMethodExp()
 
     CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<MethodExp>(move(method), move(exps));
+    return makeNode<MethodExp>(_arena, move(method), move(exps));
 }
 
 ASNPtr Parser::parseNew()
@@ -330,7 +332,7 @@ ASNPtr Parser::parseNew()
     TRACE;
     ENABLE_ROLLBACK;
 
-    Vector<ASNPtr> exps;
+    ASNList exps = makeList(_arena);
     ASNPtr temp;
 
     MATCH_(NewToken);
@@ -350,7 +352,7 @@ ASNPtr Parser::parseNew()
 
     CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<NewExp>(var, move(exps));
+    return makeNode<NewExp>(_arena, var, move(exps));
 }
 
 /**
@@ -376,176 +378,124 @@ ASNPtr Parser::parsePrimary()
     TRACE;
     ASNPtr result;
 
-    if (result = parseNumber())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseParensExp())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseUnary())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseMethodExp())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseBoolTrue())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseBoolFalse())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseNew())
+    // Each kind of primary starts with its own token.
+    switch (cur().type)
     {
-        SUCCESS;
-        return result;
+        case tokNum:    result = parseNumber(); break;
+        case tokLParen: result = parseParensExp(); break;
+        case tokNot:
+        case tokMinus:  result = parseUnary(); break;
+        case tokTrue:   result = parseBoolTrue(); break;
+        case tokFalse:  result = parseBoolFalse(); break;
+        case tokNew:    result = parseNew(); break;
+
+        case tokVar:
+        case tokThis:
+            // A variable, then '(' if it's a call.
+            if (lookahead(variableLength()) == tokLParen)
+            {
+                result = parseMethodExp();
+            }
+            else
+            {
+                result = parseVariableExp();
+            }
+            break;
+
+        default:
+            break;
     }
-    else if (result = parseVariableExp())
+
+    if (result)
     {
         SUCCESS;
-        return result;
     }
     else
     {
         FAILURE;
-        return nullptr;
     }
+
+    return result;
 }
 
-ASNPtr Parser::parseMultive()
+// Binary operators by token: their OpType and how tightly they bind.
+// Higher binds tighter; 0 means not a binary operator.
+// Every level is right-associative: 1 - 2 - 3 is 1 - (2 - 3).
+namespace
 {
-    TRACE;
-    ENABLE_ROLLBACK;
 
-    PARSE(left, parsePrimary());
-    PARSE(op, parseMultiveOp());
-    MUST_PARSE(right, parseMultiveDown(), "Expected expression after multive operator");
+enum BindingPower : unsigned
+{
+    bpNone,
+    bpLogical,
+    bpAdditive,
+    bpMultive,
+    bpPrimary,  // Above every operator: operands only.
+};
 
-    CANCEL_ROLLBACK;
-    SUCCESS;
-    return make_unique<BinopExp>(move(left), op, move(right));
-}
+struct BinaryOp
+{
+    OpType op = opPlus;
+    BindingPower power = bpNone;
+    char const* expected = nullptr;
+};
 
-ASNPtr Parser::parseMultiveDown()
+struct BinaryOpTable
 {
-    TRACE;
-    ASNPtr result;
+    BinaryOp ops[tokPrint + 1];
 
-    if (result = parseMultive())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parsePrimary())
+    constexpr BinaryOpTable()
+        : ops()
     {
-        SUCCESS;
-        return result;
+        ops[tokMult]  = { opMult,     bpMultive,  "Expected expression after multive operator" };
+        ops[tokDiv]   = { opDiv,      bpMultive,  "Expected expression after multive operator" };
+        ops[tokPlus]  = { opPlus,     bpAdditive, "Expected expression after additive operator" };
+        ops[tokMinus] = { opMinus,    bpAdditive, "Expected expression after additive operator" };
+        ops[tokAnd]   = { opAnd,      bpLogical,  "Expected expression after logical operator" };
+        ops[tokOr]    = { opOr,       bpLogical,  "Expected expression after logical operator" };
+        ops[tokEq]    = { opLogEq,    bpLogical,  "Expected expression after logical operator" };
+        ops[tokNotEq] = { opLogNotEq, bpLogical,  "Expected expression after logical operator" };
     }
-    else
+
+    constexpr BinaryOp const& operator[](TokType t) const
     {
-        FAILURE;
-        return nullptr;
+        return ops[t];
     }
-}
-
-ASNPtr Parser::parseAdditive()
-{
-    TRACE;
-    ENABLE_ROLLBACK;
+};
 
-    PARSE(left, parseMultiveDown());
-    PARSE(op, parseAdditiveOp());
-    MUST_PARSE(right, parseAdditiveDown(), "Expected expression after additive operator");
+constexpr BinaryOpTable BINOPS;
 
-    CANCEL_ROLLBACK;
-    SUCCESS;
-    return make_unique<BinopExp>(move(left), op, move(right));
-}
+} // namespace
 
-ASNPtr Parser::parseAdditiveDown()
+// Precedence climbing over BINOPS, in one pass with no backtracking.
+// Parses operands joined by operators binding at least minPower.
+ASNPtr Parser::parseBinary(unsigned minPower)
 {
     TRACE;
-    ASNPtr result;
 
-    if (result = parseAdditive())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseMultiveDown())
-    {
-        SUCCESS;
-        return result;
-    }
-    else
+    PARSE(left, parsePrimary());
+
+    while (true)
     {
-        FAILURE;
-        return nullptr;
-    }
-}
+        BinaryOp const& binop = BINOPS[cur().type];
 
-ASNPtr Parser::parseLogical()
-{
-    TRACE;
-    ENABLE_ROLLBACK;
+        if (binop.power == bpNone || binop.power < minPower)
+        {
+            break;
+        }
 
-    PARSE(left, parseAdditiveDown());
-    PARSE(op, parseLogicalOp());
-    MUST_PARSE(right, parseLogicalDown(), "Expected expression after logical operator");
+        next();
+        MUST_PARSE(right, parseBinary(binop.power), binop.expected);
+        left = makeNode<BinopExp>(_arena, move(left), binop.op, move(right));
+    }
 
-    CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<BinopExp>(move(left), op, move(right));
-}
-
-ASNPtr Parser::parseLogicalDown()
-{
-    TRACE;
-    ASNPtr result;
-
-    if (result = parseLogical())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseAdditiveDown())
-    {
-        SUCCESS;
-        return result;
-    }
-    else
-    {
-        FAILURE;
-        return nullptr;
-    }
+    return left;
 }
 
 ASNPtr Parser::parseExp()
 {
-    TRACE;
-    ASNPtr result;
-
-    if (result = parseLogicalDown())
-    {
-        SUCCESS;
-        return result;
-    }
-    else
-    {
-        FAILURE;
-        return nullptr;
-    }
+    return parseBinary(bpLogical);
 }
 
 // STATEMENT PARSERS
@@ -563,7 +513,7 @@ ASNPtr Parser::parseVarAssignDecl()
 
     CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<VarDecAssignStm>(varType, varName, move(exp));
+    return makeNode<VarDecAssignStm>(_arena, varType, varName, move(exp));
 }
 
 ASNPtr Parser::parseVarDecl()
@@ -577,7 +527,7 @@ ASNPtr Parser::parseVarDecl()
 
     CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<VarDecStm>(varType, varName);
+    return makeNode<VarDecStm>(_arena, varType, varName);
 }
 
 ASNPtr Parser::parseAssignStm()
@@ -592,7 +542,7 @@ ASNPtr Parser::parseAssignStm()
 
     CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<AssignStm>(move(lhs), move(rhs));
+    return makeNode<AssignStm>(_arena, move(lhs), move(rhs));
 }
 
 ASNPtr Parser::parseMethodStm()
@@ -606,7 +556,7 @@ ASNPtr Parser::parseMethodStm()
 
     CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<MethodStm>(move(exp));
+    return makeNode<MethodStm>(_arena, move(exp));
 }
 
 ASNPtr Parser::parseIfStm()
@@ -615,6 +565,7 @@ ASNPtr Parser::parseIfStm()
 
     ENABLE_ROLLBACK;
     MATCH_(IfToken);
+    CANCEL_ROLLBACK;
     MUST_MATCH_(LeftParenToken);
     MUST_PARSE(logicExp, parseExp(), "Expected logical expression in if statement");
     MUST_MATCH_(RightParenToken);
@@ -629,13 +580,12 @@ ASNPtr Parser::parseIfStm()
     }
     else
     {
-        elseBlock = make_unique<Block>(Vector<ASNPtr>{});
+        elseBlock = makeNode<Block>(_arena, makeList(_arena));
         hasElse = false;
     }
 
-    CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<IfStm>(
+    return makeNode<IfStm>(_arena,
         move(logicExp),
         move(trueStatements),
         hasElse,
@@ -649,14 +599,14 @@ ASNPtr Parser::parseWhileStm()
     ENABLE_ROLLBACK;
 
     MATCH_(WhileToken);
+    CANCEL_ROLLBACK;
     MUST_MATCH_(LeftParenToken);
     MUST_PARSE(cond, parseExp(), "Expected logical expression in while statement");
     MUST_MATCH_(RightParenToken);
     MUST_PARSE(body, parseBlock(), "Expected block{} after while statement");
 
-    CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<WhileStm>(move(cond), move(body));
+    return makeNode<WhileStm>(_arena, move(cond), move(body));
 }
 
 ASNPtr Parser::parseStm()
@@ -664,61 +614,60 @@ ASNPtr Parser::parseStm()
     TRACE;
     ASNPtr result;
 
-    if (result = parseVarAssignDecl())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseVarDecl())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseAssignStm())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseMethodStm())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseIfStm())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseWhileStm())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseMethodDecl())
-    {
-        SUCCESS;
-        return result;
-    }
-    else if (result = parseRetStm())
-    {
-        SUCCESS;
-        return result;
+    // Picks the one statement rule that can match, by up to four tokens.
+    switch (cur().type)
+    {
+        case tokIf:     result = parseIfStm(); break;
+        case tokWhile:  result = parseWhileStm(); break;
+        case tokReturn: result = parseRetStm(); break;
+        case tokPrint:  result = parsePrintStm(); break;
+
+        case tokVar:
+            // NAME NAME = ...  or  NAME NAME ;
+            if (lookahead(1) == tokVar)
+            {
+                if (lookahead(2) == tokAssign)
+                {
+                    result = parseVarAssignDecl();
+                }
+                else
+                {
+                    result = parseVarDecl();
+                }
+                break;
+            }
+            [[fallthrough]];
+
+        case tokThis:
+        {
+            // variable = ...  or  variable(...);
+            size_t const len = variableLength();
+
+            if (len && lookahead(len) == tokAssign)
+            {
+                result = parseAssignStm();
+            }
+            else if (len && lookahead(len) == tokLParen)
+            {
+                result = parseMethodStm();
+            }
+            break;
+        }
+
+        default:
+            break;
     }
-    else if (result = parsePrintStm())
+
+    if (result)
     {
         SUCCESS;
-        return result;
     }
-//    else if (result = parseExp())     //only for testing
-//    {
-//        SUCCESS;
-//        return result;
-//    }
     else
     {
         FAILURE;
-        return nullptr;
     }
+
+    return result;
 }
 
 // COMPOUND PARSERS
@@ -728,10 +677,11 @@ BlockPtr Parser::parseBlock()
     TRACE;
     ENABLE_ROLLBACK;
 
-    Vector<ASNPtr> stm;
+    ASNList stm = makeList(_arena);
     ASNPtr curstm = nullptr;
 
     MATCH_(LeftBraceToken);
+    CANCEL_ROLLBACK;
 
     while((curstm = parseStm()))
     {
@@ -740,9 +690,8 @@ BlockPtr Parser::parseBlock()
 
     MUST_MATCH_(RightBraceToken);
 
-    CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<Block>(move(stm));
+    return makeNode<Block>(_arena, move(stm));
 }
 
 ASNPtr Parser::parseMethodDecl()
@@ -753,12 +702,13 @@ ASNPtr Parser::parseMethodDecl()
     TRACE;
     ENABLE_ROLLBACK;
 
-    Vector<FormalArg> exps;
+    ArgList exps = makeArgs(_arena);
     Optional<FormalArg> temp;
 
     PARSE(typeName, parseName());
     PARSE(functionName, parseName());
     MATCH_(LeftParenToken);
+    CANCEL_ROLLBACK;
     temp = parseFormalArg();
     if(temp)
     {
@@ -772,13 +722,12 @@ ASNPtr Parser::parseMethodDecl()
     MUST_MATCH_(RightParenToken);
     MUST_PARSE(body, parseBlock(), "Expected block{} for method body");
 
-    CANCEL_ROLLBACK;
     SUCCESS;
 
     if((currentClass == "Main") && (functionName == "main"))
         hasMainMethod = true;
 
-    return make_unique<MethodDef>(typeName, functionName,
+    return makeNode<MethodDef>(_arena, typeName, functionName,
                                   move(exps), move(body));
 }
 
@@ -789,10 +738,11 @@ ASNPtr Parser::parseConsDecl()
     TRACE;
     ENABLE_ROLLBACK;
 
-    Vector<FormalArg> exps;
+    ArgList exps = makeArgs(_arena);
     Optional<FormalArg> temp;
 
     MATCH_(ConsToken);
+    CANCEL_ROLLBACK;
     MUST_MATCH_(LeftParenToken);
     temp = parseFormalArg();
     if (temp)
@@ -807,9 +757,8 @@ ASNPtr Parser::parseConsDecl()
     MUST_MATCH_(RightParenToken);
     MUST_PARSE(body, parseBlock(), "Expected block{} for constructor body");
 
-    CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<ConsDef>(move(exps), move(body));
+    return makeNode<ConsDef>(_arena, move(exps), move(body));
 }
 
 ASNPtr Parser::parseClassDecl()
@@ -824,11 +773,12 @@ ASNPtr Parser::parseClassDecl()
     TRACE;
     ENABLE_ROLLBACK;
 
-    Vector<ASNPtr> stm;
+    ASNList stm = makeList(_arena);
     ASNPtr curstm = nullptr;
     ClassDecl* parent = nullptr;
 
     MATCH_(ClassToken);
+    CANCEL_ROLLBACK;
     MUST_PARSE(className, parseName(), "Expected class name");
     currentClass = className;
 
@@ -838,7 +788,7 @@ ASNPtr Parser::parseClassDecl()
         parent = _classes[extName];
         if(!parent) 
         {
-            throw ParserException("Undeclared Base class: " + extName);
+            throw ParserException("Undeclared Base class: " + extName.str());
         }
     }
 
@@ -851,10 +801,9 @@ ASNPtr Parser::parseClassDecl()
     MUST_MATCH_(RightBraceToken);
     MUST_MATCH_(SemiToken);
 
-    CANCEL_ROLLBACK;
     SUCCESS;
 
-    auto result = make_unique<ClassDecl>(className, move(stm), parent);
+    auto result = makeNode<ClassDecl>(_arena, className, move(stm), parent);
     _classes.insert({className, result.get()});
     return result;
 }
@@ -864,26 +813,33 @@ ASNPtr Parser::parseClassStm()
     TRACE;
     ASNPtr result;
 
-    if (result = parseConsDecl())
+    // cons(...)  or  NAME NAME(...)  or  NAME NAME;
+    if (cur().type == tokCons)
     {
-        SUCCESS;
-        return result;
+        result = parseConsDecl();
     }
-    else if (result = parseMethodDecl())
+    else if (cur().type == tokVar)
     {
-        SUCCESS;
-        return result;
+        if (lookahead(1) == tokVar && lookahead(2) == tokLParen)
+        {
+            result = parseMethodDecl();
+        }
+        else
+        {
+            result = parseVarDecl();
+        }
     }
-    else if (result = parseVarDecl())
+
+    if (result)
     {
         SUCCESS;
-        return result;
     }
     else
     {
         FAILURE;
-        return nullptr;
     }
+
+    return result;
 }
 
 ASNPtr Parser::parseRetStm()
@@ -897,7 +853,7 @@ ASNPtr Parser::parseRetStm()
 
     CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<RetStm>(move(exp));
+    return makeNode<RetStm>(_arena, move(exp));
 }
 
 ASNPtr Parser::parsePrintStm()
@@ -913,7 +869,7 @@ ASNPtr Parser::parsePrintStm()
 
     CANCEL_ROLLBACK;
     SUCCESS;
-    return make_unique<PrintStm>(move(exp));
+    return makeNode<PrintStm>(_arena, move(exp));
 }
 
 Vector<ASNPtr> Parser::parseProgram()
@@ -939,7 +895,7 @@ Vector<ASNPtr> Parser::parseProgram()
     {
         FAILURE;
         String msg = "Unable to parse at position: " + to_string(_tokenPos)
-                + "\nUnexpected: " + _tokens[_tokenPos]->toString();
+                + "\nUnexpected: " + to_string(cur());
         throw ParserException(msg);
     }
 
@@ -950,11 +906,16 @@ Vector<ASNPtr> Parser::parseProgram()
     return prog;
 }
 
-Parser::Parser(Vector<TokenPtr> const& tokens, bool requireMain)
-    : _tokens(tokens)
+Parser::Parser(TokenStream tokens, bool requireMain, ASTArena* arena)
+    : Parser(std::make_unique<TokenStreamProducer>(std::move(tokens)), requireMain, arena)
+{
+}
+
+Parser::Parser(std::unique_ptr<TokenProducer> tokens, bool requireMain, ASTArena* arena)
+    : _tokens(std::move(tokens))
     , _tokenPos(0)
-    , _end(make_unique<EndToken>())
-    , _tracer("Parser(" + to_string(tokens) + ")", config::traceIndent)
+    , _arena(arena)
+    , _tracer("Parser", config::traceIndent)
 {
     if(requireMain)
         hasMainMethod = false;
@@ -964,7 +925,7 @@ Parser::Parser(Vector<TokenPtr> const& tokens, bool requireMain)
 
 Parser::~Parser()
 {
-    if (config::traceParse)
+    if (TRACING)
     {
         std::cout << "\n";
         _tracer.finalize();
@@ -2,16 +2,22 @@
 
 #include "parser.hpp"
 #include "token.hpp"
+#include "tokenwindow.hpp"
 #include "vector.hpp"
 #include "optional.hpp"
 #include "string.hpp"
 #include "asn.hpp"
 #include "tracer.hpp"
+#include "map.hpp"
+#include <stdexcept>
 
 namespace dflat
 {
 
-Vector<ASNPtr> parse(Vector<TokenPtr> const&);  //Main runner function for parser
+//Main runner function for parser.
+//Nodes go in arena if given; it must outlive the returned program.
+Vector<ASNPtr> parse(TokenStream, ASTArena* = nullptr);
+Vector<ASNPtr> parse(std::unique_ptr<TokenProducer>, ASTArena* = nullptr);  //Pulls tokens on demand
 
 // TODO line/column in parse errors (and the rest if possible)
 class ParserException : public std::runtime_error
@@ -22,6 +28,11 @@ public:
 
 class Parser
 {
+    // Rollbackers nest, so the live ones form a stack of marks.
+    // The oldest mark is the furthest back a rollback can go;
+    //  tokens before it are released from the window.
+    // Rules with long bodies cancel theirs once a token commits them,
+    //  so the window holds lookahead, not a whole class.
     class Rollbacker
     {
         Parser& _parser;
@@ -33,53 +44,65 @@ class Parser
             : _parser(parser)
             , _oldPos(oldPos)
             , _rollback(true)
-        {}
+        {
+            _parser._marks.push_back(oldPos);
+        }
 
         ~Rollbacker()
         {
             if (_rollback)
             {
                 _parser._tokenPos = _oldPos;
+                _parser._marks.pop_back();
             }
         }
 
         void disable()
         {
-            _rollback = false;
+            if (_rollback)
+            {
+                _rollback = false;
+                _parser._marks.pop_back();
+            }
         }
     };
 
-    Vector<TokenPtr> const& _tokens;
+    TokenWindow _tokens;
     size_t _tokenPos;
-    TokenPtr const _end;
+    Vector<size_t> _marks;
+    ASTArena* _arena;   // Null: nodes go on the heap.
     Tracer _tracer;
-    String currentClass;
+    Symbol currentClass;
     bool hasMainMethod;
 
-    Map<String, ClassDecl*> _classes;
+    Map<Symbol, ClassDecl*> _classes;
+
+    ASNPtr parseBinary(unsigned minPower);
 
-    TokenPtr const& cur() const;
+    Token const& cur();
     void next();
+    TokType lookahead(size_t n);
+    size_t variableLength();
 
+    // Matches by plain tag comparison against T::type.
+    // Returns a copy: the window may move tokens as it grows.
     template <typename T>
-    T const* match()
+    Optional<Token> match()
     {
-        T const* t = cur()->as<T>();
+        Token const t = cur();
 
-        if (t)
+        if (t.type != T::type)
         {
-            next();
+            return nullopt;
         }
 
+        next();
         return t;
     }
     
 public:
-    Optional<String> parseName();
+    Optional<Symbol> parseName();
     Optional<OpType> parseUnaryOp();
-    Optional<OpType> parseMultiveOp();
-    Optional<OpType> parseAdditiveOp();
-    Optional<OpType> parseLogicalOp();
     Optional<Variable> parseVariable();
     Optional<FormalArg> parseFormalArg();
     ASNPtr parseVariableExp();
@@ -93,12 +116,6 @@ public:
     ASNPtr parseNew();
     ASNPtr parseParensExp();
     ASNPtr parsePrimary();
-    ASNPtr parseMultive();
-    ASNPtr parseMultiveDown();
-    ASNPtr parseAdditive();
-    ASNPtr parseAdditiveDown();
-    ASNPtr parseLogical();
-    ASNPtr parseLogicalDown();
     ASNPtr parseExp();
     ASNPtr parseVarAssignDecl();
     ASNPtr parseVarDecl();
@@ -114,8 +131,12 @@ public:
     ASNPtr parseClassStm();
     Vector<ASNPtr> parseProgram();
     ASNPtr parseRetStm();
-    Parser(Vector<TokenPtr> const&, bool requireMain = true);
+    Parser(TokenStream, bool requireMain = true, ASTArena* = nullptr);
+    Parser(std::unique_ptr<TokenProducer>, bool requireMain = true, ASTArena* = nullptr);
     ~Parser();
+
+    // Ring size of the token window, for checking it stays small.
+    size_t windowCapacity() const { return _tokens.capacity(); }
 };
 
 } // namespace dflat
@@ -6,20 +6,45 @@ namespace dflat
 
 void ScopeMetaMan::push()
 {
-    _scopes.push_back({});
+    _scopeStarts.push_back(static_cast<uint32_t>(_bindings.size()));
 }
 
 void ScopeMetaMan::pop()
 {
-    _scopes.pop_back();
+    uint32_t const start = _scopeStarts.back();
+    _scopeStarts.pop_back();
+
+    // Undo this scope's bindings, newest first.
+    while (_bindings.size() > start)
+    {
+        Binding const& binding = _bindings.back();
+        _visible[binding.name.id()] = binding.shadowed;
+        _bindings.pop_back();
+    }
 }
 
-void ScopeMetaMan::declAny(String const& name, Decl const& decl)
+void ScopeMetaMan::declAny(Symbol const& name, Decl const& decl)
 {
-    _scopes.back().insert({name, decl});
+    uint32_t const id = name.id();
+
+    if (id >= _visible.size())
+    {
+        _visible.resize(id + 1, noBinding);
+    }
+
+    uint32_t const shadowed = _visible[id];
+
+    // Redeclaring in the same scope keeps the first.
+    if (shadowed != noBinding && shadowed >= _scopeStarts.back())
+    {
+        return;
+    }
+
+    _visible[id] = static_cast<uint32_t>(_bindings.size());
+    _bindings.push_back({ name, decl, shadowed });
 }
 
-void ScopeMetaMan::declLocal(String const& name, Type const& type)
+void ScopeMetaMan::declLocal(Symbol const& name, Type const& type)
 {
     Decl decl{ DeclType::local, type };
     declAny(name, decl);
@@ -28,33 +53,22 @@ void ScopeMetaMan::declLocal(String const& name, Type const& type)
 //void ScopeMetaMan::print() const
 //{
 //    std::cout << "scope_print\n";
-//    unsigned tab = 1;
-//    for (auto&& s : _scopes)
+//    for (Binding const& b : _bindings)
 //    {
-//        for (auto&& [k,v] : s)
-//        {
-//            std::cout << String(tab*2, ' ') << k << "\n";
-//        }
-//        ++tab;
+//        std::cout << "  " << b.name.str() << "\n";
 //    }
 //}
 
-Decl const* ScopeMetaMan::lookup(String const& name) const
+Decl const* ScopeMetaMan::lookup(Symbol const& name) const
 {
-    auto it = _scopes.rbegin();
-    auto const end = _scopes.rend();
+    uint32_t const id = name.id();
 
-    while (it != end)
+    if (id >= _visible.size() || _visible[id] == noBinding)
     {
-        if (Decl const* decl = dflat::lookup(*it, name))
-        {
-            return decl;
-        }
-
-        ++it;
+        return nullptr;
     }
 
-    return nullptr;
+    return &_bindings[_visible[id]].decl;
 }
 
 } // namespace dflat
@@ -5,6 +5,7 @@
 #include "vector.hpp"
 #include "type.hpp"
 #include "optional.hpp"
+#include <cstdint>
 
 namespace dflat
 {
@@ -27,14 +28,33 @@ class ScopeMetaMan
     public:
         void push();
         void pop();
-        void declLocal(String const&, Type const&);
+        void declLocal(Symbol const&, Type const&);
 //        void print() const;
-        Decl const* lookup(String const&) const;
+
+        // Valid until the next declaration.
+        Decl const* lookup(Symbol const&) const;
 
     private:
-        void declAny(String const&, Decl const&);
-        
-        Vector<Map<String, Decl>> _scopes = {{}};
+        // A declaration and the one it hides, restored on pop.
+        struct Binding
+        {
+            Symbol name;
+            Decl decl;
+            uint32_t shadowed;
+        };
+
+        static constexpr uint32_t noBinding = UINT32_MAX;
+
+        void declAny(Symbol const&, Decl const&);
+
+        // Innermost binding of each name, by Symbol id.
+        Vector<uint32_t> _visible;
+
+        // Live bindings, innermost scope last.
+        Vector<Binding> _bindings;
+
+        // Where each open scope's bindings start.
+        Vector<uint32_t> _scopeStarts = { 0 };
 };
 
 } // namespace dflat
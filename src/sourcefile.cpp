@@ -0,0 +1,122 @@
+#include "sourcefile.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dflat
+{
+
+SourceFileException::SourceFileException(String msg) noexcept
+    : std::runtime_error("Error: " + std::move(msg))
+{}
+
+SourceFile::SourceFile(FilePath const& path)
+{
+    if (path == "-")
+    {
+        readAll(STDIN_FILENO);
+        return;
+    }
+
+    int const fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        throw SourceFileException("Cannot open '" + path + "': " 
+                + std::strerror(errno));
+    }
+
+    if (!tryMap(fd))
+    {
+        readAll(fd);
+    }
+
+    ::close(fd);
+}
+
+SourceFile::~SourceFile()
+{
+    if (_map)
+    {
+        ::munmap(_map, _mapSize);
+    }
+}
+
+std::string_view SourceFile::text() const
+{
+    return _text;
+}
+
+bool SourceFile::isMapped() const
+{
+    return _map != nullptr;
+}
+
+// Maps a regular file. Returns false if fd can't be mapped.
+bool SourceFile::tryMap(int fd)
+{
+    struct stat st;
+
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        return false;
+    }
+
+    size_t const size = static_cast<size_t>(st.st_size);
+
+    if (size == 0)
+    {
+        // Can't map nothing; an empty view is fine.
+        return true;
+    }
+
+    void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (p == MAP_FAILED)
+    {
+        return false;
+    }
+
+    // The lexer reads front to back, once.
+    ::madvise(p, size, MADV_SEQUENTIAL);
+
+    _map = p;
+    _mapSize = size;
+    _text = std::string_view(static_cast<char const*>(p), size);
+    return true;
+}
+
+void SourceFile::readAll(int fd)
+{
+    char chunk[1 << 16];
+
+    while (true)
+    {
+        ssize_t const n = ::read(fd, chunk, sizeof chunk);
+
+        if (n == 0)
+        {
+            break;
+        }
+
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw SourceFileException(String("Cannot read input: ")
+                    + std::strerror(errno));
+        }
+
+        _buffer.append(chunk, static_cast<size_t>(n));
+    }
+
+    _text = _buffer;
+}
+
+} // namespace dflat
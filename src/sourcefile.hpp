@@ -0,0 +1,42 @@
+#pragma once
+
+#include "string.hpp"
+#include <stdexcept>
+#include <string_view>
+
+namespace dflat
+{
+
+// Read-only source text for the lexer.
+// Regular files are memory-mapped, so the text is never copied.
+// Anything that can't be mapped (stdin, pipes) is read into a buffer.
+class SourceFile
+{
+    public:
+        // "-" reads standard input.
+        explicit SourceFile(FilePath const&);
+        ~SourceFile();
+
+        SourceFile(SourceFile const&) = delete;
+        SourceFile& operator=(SourceFile const&) = delete;
+
+        std::string_view text() const;
+        bool isMapped() const;
+
+    private:
+        bool tryMap(int fd);
+        void readAll(int fd);
+
+        void* _map = nullptr;
+        size_t _mapSize = 0;
+        String _buffer;
+        std::string_view _text;
+};
+
+class SourceFileException : public std::runtime_error
+{
+    public:
+        SourceFileException(String msg) noexcept;
+};
+
+} // namespace dflat
@@ -1,19 +1,66 @@
 #include "token.hpp"
+#include <cstdlib>
 
 namespace dflat
 {
 
-String to_string(TokenPtr const& token)
+char const* tokSpelling(TokType type)
 {
-    return token->toString();
+    switch (type)
+    {
+        case tokNum:        return "";
+        case tokVar:        return "";
+        case tokIf:         return "if";
+        case tokElse:       return "else";
+        case tokPlus:       return "+";
+        case tokMinus:      return "-";
+        case tokDiv:        return "/";
+        case tokAssign:     return "=";
+        case tokMult:       return "*";
+        case tokRBrace:     return "}";
+        case tokLBrace:     return "{";
+        case tokLParen:     return "(";
+        case tokRParen:     return ")";
+        case tokComma:      return ",";
+        case tokSemi:       return ";";
+        case tokWhile:      return "while";
+        case tokAnd:        return "&&";
+        case tokOr:         return "||";
+        case tokEq:         return "==";
+        case tokNotEq:      return "!=";
+        case tokNot:        return "!";
+        case tokMember:     return ".";
+        case tokTrue:       return "true";
+        case tokFalse:      return "false";
+        case tokEnd:        return "END";
+        case tokNew:        return "new";
+        case tokReturn:     return "return";
+        case tokThis:       return "this";
+        case tokClass:      return "class";
+        case tokExtends:    return "extends";
+        case tokCons:       return "cons";
+        case tokPrint:      return "print";
+    }
+
+    std::abort(); // Unhandled token type.
+}
+
+String to_string(Token const& t)
+{
+    switch (t.type)
+    {
+        case tokNum:    return to_string(t.num);
+        case tokVar:    return t.symbol().str();
+        default:        return tokSpelling(t.type);
+    }
 }
 
-String to_string(Vector<TokenPtr> const& tokens)
+String to_string(TokenStream const& tokens)
 {
     String s;
     bool first = true;
-    
-    for (TokenPtr const& t : tokens)
+
+    for (Token const& t : tokens)
     {
         if (first)
         {
@@ -24,15 +71,34 @@ String to_string(Vector<TokenPtr> const& tokens)
             s += " ";
         }
 
-        s += t->toString();
+        s += tokens.toString(t);
     }
 
     return s;
 }
 
-//Token:
-Token::~Token()
+//TokenStream:
+TokenStream::TokenStream(Vector<Token> tokens)
+    : _tokens(std::move(tokens))
+{
+}
+
+// Span of len following the last token and a separating space.
+Token TokenStream::spanNext(size_t len)
+{
+    uint32_t pos = 0;
+
+    if (!_tokens.empty())
+    {
+        pos = _tokens.back().pos + _tokens.back().len + 1;
+    }
+
+    return Token{ tokEnd, pos, static_cast<uint32_t>(len), { 0 } };
+}
+
+String TokenStream::toString(Token const& t) const
 {
+    return to_string(t);
 }
 
 //NumberToken:
@@ -42,7 +108,7 @@ NumberToken::NumberToken(int num_)
 }
 
 //NameToken:
-NameToken::NameToken(String const& name_)
+NameToken::NameToken(Symbol const& name_)
     : name(name_)
 {
 }
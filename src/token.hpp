@@ -3,7 +3,8 @@
 
 #include "string.hpp"
 #include "vector.hpp"
-#include <memory>
+#include "symbol.hpp"
+#include <cstdint>
 
 namespace dflat
 {
@@ -14,259 +15,128 @@ namespace dflat
                     tokTrue, tokFalse, tokEnd, tokNew, tokReturn,
                     tokThis, tokClass, tokExtends, tokCons, tokPrint};
 
-    class Token
-    {
-    public:
-        virtual ~Token();
-        virtual TokType getType() const = 0;
-        virtual String toString() const = 0;
-
-        template <typename T>
-        T* as()
-        {
-            return dynamic_cast<T*>(this);
-        }
-        
-        template <typename T>
-        T const* as() const
-        {
-            return dynamic_cast<T const*>(this);
-        }
-    };
-
-    using TokenPtr = std::unique_ptr<Token>;
-
-    class NumberToken : public Token
-    {
-    public:
-        int num;
-        NumberToken(int);
-        TokType getType() const { return tokNum; }
-        String toString() const { return to_string(num); }
-    };
-
-    class NameToken : public Token
-    {
-    public:
-        String name;
-        NameToken(String const&);
-        TokType getType() const { return tokVar; }
-        String toString() const { return name; }
-    };
-
-    class IfToken : public Token
-    {
-    public:
-        TokType getType() const { return tokIf; }
-        String toString() const { return "if"; }
-    };
-
-    class ElseToken : public Token
-    {
-    public:
-        TokType getType() const { return tokElse; }
-        String toString() const { return "else"; }
-    };
-
-    class PlusToken : public Token
-    {
-    public:
-        TokType getType() const { return tokPlus; }
-        String toString() const { return "+"; }
-    };
+    // Fixed spelling of a token type. Names and numbers have none.
+    char const* tokSpelling(TokType);
 
-    class MinusToken : public Token
+    // A single lexed token.
+    // Tokens are plain values stored contiguously in a TokenStream.
+    // pos/len is the token's span in the stream's text.
+    struct Token
     {
-    public:
-        TokType getType() const { return tokMinus; }
-        String toString() const { return "-"; }
-    };
+        TokType type;
+        uint32_t pos;
+        uint32_t len;
 
-    class MultiplyToken : public Token
-    {
-    public:
-        TokType getType() const { return tokMult; }
-        String toString() const { return "*"; }
-    };
-
-    class DivisionToken : public Token
-    {
-    public:
-        TokType getType() const { return tokDiv; }
-        String toString() const { return "/"; }
-    };
-
-    class AssignToken : public Token
-    {
-    public:
-        TokType getType() const { return tokAssign; }
-        String toString() const { return "="; }
-    };
-
-    class LeftBraceToken : public Token
-    {
-    public:
-        TokType getType() const { return tokLBrace; }
-        String toString() const { return "{"; }
-    };
-
-    class RightBraceToken : public Token
-    {
-    public:
-        TokType getType() const { return tokRBrace; }
-        String toString() const { return "}"; }
-    };
-
-    class LeftParenToken : public Token
-    {
-    public:
-        TokType getType() const { return tokLParen; }
-        String toString() const { return "("; }
-    };
-
-    class RightParenToken : public Token
-    {
-    public:
-        TokType getType() const { return tokRParen; }
-        String toString() const { return ")"; }
-    };
-
-    class CommaToken : public Token
-    {
-    public:
-        TokType getType() const { return tokComma; }
-        String toString() const { return ","; }
-    };
-
-    class SemiToken : public Token
-    {
-    public:
-        TokType getType() const { return tokSemi; }
-        String toString() const { return ";"; }
-    };
-
-    class WhileToken : public Token
-    {
-    public:
-        TokType getType() const { return tokWhile; }
-        String toString() const { return "while"; }
-    };
+        union
+        {
+            int num;        // tokNum
+            uint32_t sym;   // tokVar: interned Symbol id
+        };
 
-    class AndToken : public Token
-    {
-    public:
-        TokType getType() const { return tokAnd; }
-        String toString() const { return "&&"; }
+        Symbol symbol() const { return Symbol::fromId(sym); }
     };
 
-	class OrToken : public Token
-	{
-	public:
-        TokType getType() const { return tokOr; }
-        String toString() const { return "||"; }
-	};
-	
-    class EqToken : public Token
-	{
-	public:
-        TokType getType() const { return tokEq; }
-        String toString() const { return "=="; }
-	};
-	
-    class NotEqToken : public Token
-	{
-	public:
-        TokType getType() const { return tokNotEq; }
-        String toString() const { return "!="; }
-	};
-
-    class NotToken : public Token //!
+    // Token types used to name what the parser matches,
+    //  and to build TokenStreams by hand.
+    template <TokType T>
+    struct FixedToken
     {
-    public:
-        TokType getType() const { return tokNot; }
-        String toString() const { return "!"; }
+        static constexpr TokType type = T;
+        String toString() const { return tokSpelling(T); }
     };
 
-    class TrueToken : public Token
+    struct NumberToken
     {
-        public:
-            TokType getType() const { return tokTrue; }
-            String toString() const { return "true"; }
-    };
-    
-    class FalseToken : public Token
-    {
-        public:
-            TokType getType() const { return tokFalse; }
-            String toString() const { return "false"; }
-    };
-
-    class MemberToken : public Token //!
-    {
-    public:
-        TokType getType() const { return tokMember; }
-        String toString() const { return "."; }
+        static constexpr TokType type = tokNum;
+        int num;
+        NumberToken(int);
+        String toString() const { return to_string(num); }
     };
 
-    // Not tokenized.
-    class EndToken : public Token
-    {
-        public:
-            TokType getType() const { return tokEnd; }
-            String toString() const { return "END"; }
-    };
+    struct NameToken
+    {
+        static constexpr TokType type = tokVar;
+        Symbol name;
+        NameToken(Symbol const&);
+        String toString() const { return name.str(); }
+    };
+
+    using IfToken         = FixedToken<tokIf>;
+    using ElseToken       = FixedToken<tokElse>;
+    using PlusToken       = FixedToken<tokPlus>;
+    using MinusToken      = FixedToken<tokMinus>;
+    using MultiplyToken   = FixedToken<tokMult>;
+    using DivisionToken   = FixedToken<tokDiv>;
+    using AssignToken     = FixedToken<tokAssign>;
+    using LeftBraceToken  = FixedToken<tokLBrace>;
+    using RightBraceToken = FixedToken<tokRBrace>;
+    using LeftParenToken  = FixedToken<tokLParen>;
+    using RightParenToken = FixedToken<tokRParen>;
+    using CommaToken      = FixedToken<tokComma>;
+    using SemiToken       = FixedToken<tokSemi>;
+    using WhileToken      = FixedToken<tokWhile>;
+    using AndToken        = FixedToken<tokAnd>;
+    using OrToken         = FixedToken<tokOr>;
+    using EqToken         = FixedToken<tokEq>;
+    using NotEqToken      = FixedToken<tokNotEq>;
+    using NotToken        = FixedToken<tokNot>;
+    using TrueToken       = FixedToken<tokTrue>;
+    using FalseToken      = FixedToken<tokFalse>;
+    using MemberToken     = FixedToken<tokMember>;
+    using EndToken        = FixedToken<tokEnd>; // Not tokenized.
+    using NewToken        = FixedToken<tokNew>;
+    using ReturnToken     = FixedToken<tokReturn>;
+    using ThisToken       = FixedToken<tokThis>;
+    using ClassToken      = FixedToken<tokClass>;
+    using ExtendsToken    = FixedToken<tokExtends>;
+    using ConsToken       = FixedToken<tokCons>;
+    using PrintToken      = FixedToken<tokPrint>;
+
+    // Contiguous tokens. Spans are offsets into the lexed source,
+    //  which the stream does not keep; names are read through symbols.
+    class TokenStream
+    {
+    public:
+        TokenStream() = default;
+        TokenStream(Vector<Token> tokens);
+
+        // Appends a token that isn't backed by source.
+        // Used to build streams by hand, e.g. from NameToken("x").
+        // Spans are then offsets into to_string() of the stream.
+        template <typename T>
+        void append(T const& t)
+        {
+            Token tok = spanNext(t.toString().size());
+            tok.type = T::type;
+
+            if constexpr (T::type == tokNum)
+            {
+                tok.num = t.num;
+            }
+            else if constexpr (T::type == tokVar)
+            {
+                tok.sym = t.name.id();
+            }
+
+            _tokens.push_back(tok);
+        }
 
-    class NewToken : public Token
-    {
-        public:
-            TokType getType() const { return tokNew; }
-            String toString() const { return "new"; }
-    };
-    
-    class ReturnToken : public Token
-    {
-        public:
-            TokType getType() const { return tokReturn; }
-            String toString() const { return "return"; }
-    };
+        size_t size() const { return _tokens.size(); }
+        bool empty() const { return _tokens.empty(); }
+        Token const& operator[](size_t i) const { return _tokens[i]; }
+        Vector<Token>::const_iterator begin() const { return _tokens.begin(); }
+        Vector<Token>::const_iterator end() const { return _tokens.end(); }
 
-    class ThisToken : public Token
-    {
-        public:
-            TokType getType() const { return tokThis; }
-            String toString() const { return "this"; }
-    };
+        String toString(Token const&) const;
 
-    class ClassToken : public Token
-    {
-        public:
-            TokType getType() const { return tokClass; }
-            String toString() const { return "class"; }
-    };
+    private:
+        Token spanNext(size_t len);
 
-    class ExtendsToken : public Token
-    {
-        public:
-            TokType getType() const { return tokExtends; }
-            String toString() const { return "extends"; }
-    };
-    
-    class ConsToken : public Token
-    {
-        public:
-            TokType getType() const { return tokCons; }
-            String toString() const { return "cons"; }
+        Vector<Token> _tokens;
     };
 
-    class PrintToken : public Token
-    {
-        public:
-            TokType getType() const { return tokPrint; }
-            String toString() const { return "print"; }
-    };
-    
-    String to_string(TokenPtr const&);
-    String to_string(Vector<TokenPtr> const&);
+    String to_string(Token const&);
+    String to_string(TokenStream const&);
 
 } //namespace dflat
 
@@ -0,0 +1,109 @@
+#include "tokenwindow.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace dflat
+{
+
+//TokenStreamProducer:
+TokenStreamProducer::TokenStreamProducer(TokenStream tokens)
+    : _tokens(std::move(tokens))
+    , _next(0)
+{
+}
+
+Optional<Token> TokenStreamProducer::nextToken()
+{
+    if (_next >= _tokens.size())
+    {
+        return nullopt;
+    }
+
+    return _tokens[_next++];
+}
+
+//TokenWindow:
+TokenWindow::TokenWindow(std::unique_ptr<TokenProducer> producer,
+                         size_t initialCapacity)
+    : _producer(std::move(producer))
+    , _head(0)
+    , _base(0)
+    , _count(0)
+    , _done(false)
+    , _end(Token{ tokEnd, 0, 0, { 0 } })
+{
+    size_t cap = 1;
+
+    while (cap < initialCapacity)
+    {
+        cap *= 2;
+    }
+
+    _ring.resize(cap);
+}
+
+// Pulls tokens up to and including pos.
+Token const& TokenWindow::fill(size_t pos)
+{
+    if (pos < _base)
+    {
+        throw std::logic_error("Token " + std::to_string(pos)
+                + " was released (window starts at " + std::to_string(_base) + ")");
+    }
+
+    while (!_done && pos >= _base + _count)
+    {
+        Optional<Token> tok = _producer->nextToken();
+
+        if (!tok)
+        {
+            _done = true;
+            break;
+        }
+
+        if (_count == _ring.size())
+        {
+            grow();
+        }
+
+        _ring[(_head + _count) & (_ring.size() - 1)] = *tok;
+        ++_count;
+    }
+
+    if (pos >= _base + _count)
+    {
+        return _end;
+    }
+
+    return _ring[(_head + (pos - _base)) & (_ring.size() - 1)];
+}
+
+// Doubles the ring, unwrapping the kept tokens to the front.
+void TokenWindow::grow()
+{
+    Vector<Token> bigger(_ring.size() * 2);
+
+    for (size_t i = 0; i < _count; ++i)
+    {
+        bigger[i] = _ring[(_head + i) & (_ring.size() - 1)];
+    }
+
+    _ring = std::move(bigger);
+    _head = 0;
+}
+
+void TokenWindow::release(size_t pos)
+{
+    if (pos <= _base)
+    {
+        return;
+    }
+
+    size_t const drop = std::min(pos - _base, _count);
+    _head = (_head + drop) & (_ring.size() - 1);
+    _base += drop;
+    _count -= drop;
+}
+
+} // namespace dflat
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "token.hpp"
+#include "optional.hpp"
+#include "vector.hpp"
+#include <memory>
+
+namespace dflat
+{
+
+// Hands out tokens one at a time, e.g. a lexer working through its input.
+class TokenProducer
+{
+    public:
+        virtual ~TokenProducer() = default;
+
+        // Next token, or nullopt once the input is used up.
+        virtual Optional<Token> nextToken() = 0;
+};
+
+// Produces the tokens of an already lexed stream.
+class TokenStreamProducer : public TokenProducer
+{
+    public:
+        explicit TokenStreamProducer(TokenStream);
+        Optional<Token> nextToken() override;
+
+    private:
+        TokenStream _tokens;
+        size_t _next;
+};
+
+// Lookahead over a TokenProducer, pulled on demand.
+// Tokens are addressed by their absolute index in the input.
+// Only tokens from the release point onward are kept, in a ring buffer
+//  that doubles when a reader looks further ahead than it holds.
+class TokenWindow
+{
+    public:
+        explicit TokenWindow(std::unique_ptr<TokenProducer>,
+                             size_t initialCapacity = 64);
+
+        // Token at index pos, or the end token past the last one.
+        // Throws std::logic_error below the release point.
+        Token const& at(size_t pos)
+        {
+            size_t const off = pos - _base;
+
+            if (off < _count)
+            {
+                return _ring[(_head + off) & (_ring.size() - 1)];
+            }
+
+            return fill(pos);
+        }
+
+        // True iff pos is past the last token.
+        bool atEnd(size_t pos)
+        {
+            return at(pos).type == tokEnd && pos >= _base + _count;
+        }
+
+        // Tokens below pos won't be asked for again.
+        // Tokens not yet pulled are never skipped.
+        void release(size_t pos);
+
+        size_t capacity() const { return _ring.size(); }
+        size_t buffered() const { return _count; }
+
+    private:
+        Token const& fill(size_t pos);
+        void grow();
+
+        std::unique_ptr<TokenProducer> _producer;
+        Vector<Token> _ring;    // Size is a power of two.
+        size_t _head;           // Ring slot of token _base.
+        size_t _base;           // Index of the oldest kept token.
+        size_t _count;          // Tokens kept.
+        bool _done;
+        Token const _end;
+};
+
+} // namespace dflat
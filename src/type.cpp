@@ -1,16 +1,17 @@
 #include "type.hpp"
 #include "map.hpp"
+#include <algorithm>
 #include <stdexcept>
 
 namespace dflat
 {
 
 Type::Type(ValueType const& value)
-    : Base(value)
+    : _id(TypeTable::global().intern(value))
 {}
 
 Type::Type(MethodType const& method)
-    : Base(method)
+    : _id(TypeTable::global().intern(method))
 {}
 
 void Type::assertValue() const
@@ -32,56 +33,84 @@ void Type::assertMethod() const
 ValueType const& Type::value() const
 {
     assertValue();
-    return get_unchecked<ValueType>();
-}
-
-ValueType& Type::value()
-{
-    assertValue();
-    return get_unchecked<ValueType>();
+    return TypeTable::global().value(_id);
 }
 
 MethodType const& Type::method() const
 {
     assertMethod();
-    return get_unchecked<MethodType>();
-}
-
-MethodType& Type::method()
-{
-    assertMethod();
-    return get_unchecked<MethodType>();
+    return TypeTable::global().method(_id);
 }
 
 bool Type::isValue() const
 {
-    return is<ValueType>();
+    return !isMethod();
 }
 
 bool Type::isMethod() const
 {
-    return is<MethodType>();
+    return TypeTable::global().isMethod(_id);
 }
 
 String Type::toString() const
 {
-    return this->match([](auto const& t)
-    {
-        return t.toString();
-    });
+    return isMethod() ? method().toString()
+                      : value().toString();
 }
 
-bool Type::operator==(Type const& other) const
+
+TypeId TypeTable::intern(ValueType const& type)
 {
-    return static_cast<Base const&>(*this)
-        == static_cast<Base const&>(other);
+    uint32_t const name = type.name().id();
+
+    if (name >= _valueIds.size())
+    {
+        _valueIds.resize(name + 1, noId);
+    }
+
+    if (_valueIds[name] == noId)
+    {
+        _valueIds[name] = static_cast<TypeId>(_entries.size());
+        _entries.push_back({ false, static_cast<uint32_t>(_values.size()) });
+        _values.push_back(type);
+    }
+
+    return _valueIds[name];
 }
 
-bool Type::operator!=(Type const& other) const
+TypeId TypeTable::intern(MethodType const& type)
 {
-    return !(*this == other);
+    return intern(type.ret(), type.args().data(), type.args().size());
 }
 
+TypeId TypeTable::intern(ValueType const& ret, ValueType const* args, size_t count)
+{
+    size_t h = ret.name().hash();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        h = h * 31 + args[i].name().hash();
+    }
+
+    auto [first, last] = _methodIds.equal_range(h);
+
+    for (auto it = first; it != last; ++it)
+    {
+        MethodType const& m = method(it->second);
+
+        if (m.ret() == ret && std::equal(args, args + count, 
+                    m.args().begin(), m.args().end()))
+        {
+            return it->second;
+        }
+    }
+
+    TypeId const id = static_cast<TypeId>(_entries.size());
+    _entries.push_back({ true, static_cast<uint32_t>(_methods.size()) });
+    _methods.push_back(MethodType(ret, Vector<ValueType>(args, args + count)));
+    _methodIds.insert({ h, id });
+    return id;
+}
 
 ValueType::ValueType(TypeName const& name)
     : _name(name)
@@ -94,7 +123,7 @@ TypeName const& ValueType::name() const
 
 String ValueType::toString() const
 {
-    return _name;
+    return _name.str();
 }
 
 bool ValueType::operator==(ValueType const& other) const
@@ -120,7 +149,7 @@ MethodType::MethodType(ValueType const& ret, Vector<ValueType> const& args)
 
 String MethodType::toString() const
 {
-    String s = _ret.name() + "(";
+    String s = _ret.toString() + "(";
     bool first = true;
 
     for (ValueType const& arg : _args)
@@ -134,7 +163,7 @@ String MethodType::toString() const
             s += ",";
         }
 
-        s += arg.name();
+        s += arg.toString();
     }
 
     s += ")";
@@ -202,3 +231,4 @@ char const* translateBuiltinType(ValueType const& type)
 }
 
 } // namespace dflat
+
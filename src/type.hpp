@@ -2,12 +2,15 @@
 
 #include "string.hpp"
 #include "vector.hpp"
-#include "variant.hpp"
+#include "symbol.hpp"
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
 
 namespace dflat
 {
 
-using TypeName = String;
+using TypeName = Symbol;
 
 // A simple type consisting only of a name.
 // Can be used as a key in a Set or Map.
@@ -45,10 +48,20 @@ class MethodType
         bool operator!=(MethodType const&) const;
 };
 
+using TypeId = uint32_t;
+
 // Either a ValueType or MethodType.
-class Type : private Variant<ValueType, MethodType>
+// A handle into the TypeTable: equal types share one TypeId, so
+//  copying, comparing and hashing a Type never touch the type itself.
+class Type
 {
-    using Base = Variant<ValueType, MethodType>;
+    TypeId _id;
+
+    struct FromId {};
+
+    Type(FromId, TypeId id)
+        : _id(id)
+    {}
 
     void assertValue() const;
     void assertMethod() const;
@@ -57,17 +70,58 @@ class Type : private Variant<ValueType, MethodType>
         Type(ValueType const&);
         Type(MethodType const&);
 
+        static Type fromId(TypeId id)
+        {
+            return Type(FromId{}, id);
+        }
+
+        TypeId id() const { return _id; }
+
         // SubType selectors. They throw when wrong.
         ValueType const& value() const;
-        ValueType& value();
         MethodType const& method() const;
-        MethodType& method();
 
         bool isValue() const;
         bool isMethod() const;
         String toString() const;
-        bool operator==(Type const&) const;
-        bool operator!=(Type const&) const;
+        bool operator==(Type const& other) const { return _id == other._id; }
+        bool operator!=(Type const& other) const { return _id != other._id; }
+};
+
+// Every distinct type, stored once.
+// Entries are never freed, so references to them stay valid.
+class TypeTable
+{
+    struct Entry
+    {
+        bool isMethod;
+        uint32_t index;     // Into _values or _methods.
+    };
+
+    std::deque<ValueType> _values;
+    std::deque<MethodType> _methods;
+    Vector<Entry> _entries;
+    Vector<TypeId> _valueIds;   // By TypeName id; noId when absent.
+    std::unordered_multimap<size_t, TypeId> _methodIds;  // By hash.
+
+    static constexpr TypeId noId = UINT32_MAX;
+
+    public:
+        static TypeTable& global()
+        {
+            static TypeTable table;
+            return table;
+        }
+
+        TypeId intern(ValueType const&);
+        TypeId intern(MethodType const&);
+        TypeId intern(ValueType const& ret, ValueType const* args, size_t count);  // Allocates only when new
+
+        bool isMethod(TypeId id) const { return _entries[id].isMethod; }
+        ValueType const& value(TypeId id) const { return _values[_entries[id].index]; }
+        MethodType const& method(TypeId id) const { return _methods[_entries[id].index]; }
+
+        size_t size() const { return _entries.size(); }
 };
 
 // Type that can't be used.
@@ -98,4 +152,13 @@ struct hash<dflat::ValueType>
     }
 };
 
+template <>
+struct hash<dflat::Type>
+{
+    size_t operator()(dflat::Type const& x) const
+    {
+        return x.id();
+    }
+};
+
 } // namespace std
@@ -13,7 +13,6 @@ TypeCheckerException::TypeCheckerException(String msg) noexcept
 
 TypeEnv::TypeEnv()
 {
-    initialize();
 }
 
 void TypeEnv::enterClass(ValueType const& classType)
@@ -45,7 +44,7 @@ void TypeEnv::leaveClass()
     _classes.leave();
 }
 
-void TypeEnv::addClassVar(String const& name, ValueType const& type)
+void TypeEnv::addClassVar(Symbol const& name, ValueType const& type)
 {
     _classes.addVar(name, type);
 }
@@ -99,18 +98,17 @@ MethodMeta const& TypeEnv::curMethod() const
     return *_curMethod;
 }
 
-void TypeEnv::setMethodMeta(ASN const* node, 
-        ValueType const& objectType, CanonName const& name)
+MethodMeta TypeEnv::methodMeta(ValueType const& objectType, CanonName const& name) const
 {
     Optional<MemberMeta> member = _classes.lookupMethod(objectType, name);
 
     if (!member)
     {
-        throw std::logic_error("setMethodMeta: no method '" + name.canonName() 
+        throw std::logic_error("methodMeta: no method '" + name.canonName() 
                 + "' in '" + objectType.toString() + "'");
     }
 
-    _methods.setMeta(node, MethodMeta{ member->baseClassType, name });
+    return MethodMeta{ member->baseClassType, name };
 }
 
 void TypeEnv::enterScope()
@@ -123,7 +121,7 @@ void TypeEnv::leaveScope()
     _scopes.pop();
 }
 
-void TypeEnv::declareLocal(String const& name, ValueType const& type)
+void TypeEnv::declareLocal(Symbol const& name, ValueType const& type)
 {
     if (!_curMethod)
     {
@@ -133,26 +131,99 @@ void TypeEnv::declareLocal(String const& name, ValueType const& type)
     _scopes.declLocal(name, type);
 }
 
-Type TypeEnv::lookupRuleType(CanonName const& name) const
+namespace
 {
-    Type const* type = lookup(_rules, name);
+    // Builtin operand types, as indices into OPTYPES.
+    // Any other type is biOther; a unary operator's missing lhs is biAbsent.
+    enum BuiltinId : uint8_t { biOther, biInt, biBool, biAbsent, biCount };
 
-    if (type)
+    BuiltinId builtinId(ValueType const& type)
     {
-        return *type;
+        if (type == intType)
+        {
+            return biInt;
+        }
+
+        return type == boolType ? biBool : biOther;
     }
-    else
+
+    // Result of each builtin operator by operand types.
+    // biOther where the operands are invalid.
+    struct OpTypeTable
     {
-        throw TypeCheckerException("Invalid operands to operator: " + name.canonName());
+        BuiltinId result[opCount][biCount][biCount];
+
+        constexpr OpTypeTable()
+            : result()
+        {
+            result[opPlus] [biInt][biInt] = biInt; // int +(int,int)
+            result[opMinus][biInt][biInt] = biInt;
+            result[opMult] [biInt][biInt] = biInt;
+            result[opDiv]  [biInt][biInt] = biInt;
+
+            result[opLogEq]   [biInt][biInt] = biBool; // bool ==(int,int)
+            result[opLogNotEq][biInt][biInt] = biBool;
+
+            result[opLogEq]   [biBool][biBool] = biBool;
+            result[opLogNotEq][biBool][biBool] = biBool;
+
+            result[opAnd][biBool][biBool] = biBool; // bool &&(bool,bool)
+            result[opOr] [biBool][biBool] = biBool;
+
+            result[opAnd][biInt][biInt] = biBool; // bool &&(int,int)
+            result[opOr] [biInt][biInt] = biBool;
+
+            result[opMinus][biAbsent][biInt]  = biInt;  // int -(int)
+            result[opNot]  [biAbsent][biBool] = biBool; // bool !(bool)
+        }
+    };
+
+    constexpr OpTypeTable OPTYPES;
+
+    Type const& builtinType(BuiltinId id)
+    {
+        // By BuiltinId.
+        static Type const types[] = { undefinedType, intType, boolType };
+        return types[id];
+    }
+
+    // Only reached for invalid operands, including all non-builtin ones.
+    TypeCheckerException invalidOperands(CanonName const& name)
+    {
+        return TypeCheckerException("Invalid operands to operator: " + name.canonName());
     }
 }
 
-MethodType TypeEnv::lookupMethodType(CanonName const& methodName) const
+Type TypeEnv::lookupOpType(OpType op, ValueType const& rhs) const
+{
+    BuiltinId const result = OPTYPES.result[op][biAbsent][builtinId(rhs)];
+
+    if (result == biOther)
+    {
+        throw invalidOperands(CanonName(opSymbol(op), undefinedType, { rhs }));
+    }
+
+    return builtinType(result);
+}
+
+Type TypeEnv::lookupOpType(OpType op, ValueType const& lhs, ValueType const& rhs) const
+{
+    BuiltinId const result = OPTYPES.result[op][builtinId(lhs)][builtinId(rhs)];
+
+    if (result == biOther)
+    {
+        throw invalidOperands(CanonName(opSymbol(op), undefinedType, { lhs, rhs }));
+    }
+
+    return builtinType(result);
+}
+
+MethodType const& TypeEnv::lookupMethodType(CanonName const& methodName) const
 {
     return lookupMethodTypeByClass(_classes.cur()->type, methodName);
 }
 
-MethodType TypeEnv::lookupMethodTypeByClass(ValueType const& classType,
+MethodType const& TypeEnv::lookupMethodTypeByClass(ValueType const& classType,
         CanonName const& methodName) const
 {
     Optional<MemberMeta> member = _classes.lookupMethod(classType, methodName);
@@ -174,7 +245,7 @@ MethodType TypeEnv::lookupMethodTypeByClass(ValueType const& classType,
     return member->type.method();
 }
             
-ValueType TypeEnv::lookupVarType(String const& varName) const
+ValueType TypeEnv::lookupVarType(Symbol const& varName) const
 {
     Decl const* decl = _scopes.lookup(varName);
 
@@ -184,7 +255,7 @@ ValueType TypeEnv::lookupVarType(String const& varName) const
 
         if (!varType.isValue())
         {
-            throw TypeCheckerException("Referenced var name '" + varName
+            throw TypeCheckerException("Referenced var name '" + varName.str()
                 + " is not a variable type");
         }
 
@@ -202,24 +273,24 @@ ValueType TypeEnv::lookupVarType(String const& varName) const
         }
         else
         {
-            throw TypeCheckerException("Undeclared var name '" + varName + "'");
+            throw TypeCheckerException("Undeclared var name '" + varName.str() + "'");
         }
     }
 }
 
 ValueType TypeEnv::lookupVarTypeByClass(ValueType const& classType,
-        String const& memberName) const
+        Symbol const& memberName) const
 {
     Optional<MemberMeta> member = _classes.lookupVar(classType, memberName);
 
     if (!member)
     {
-        throw TypeCheckerException("Undeclared member var name '" + memberName + "'");
+        throw TypeCheckerException("Undeclared member var name '" + memberName.str() + "'");
     }
 
     if (!member->type.isValue())
     {
-        throw TypeCheckerException("Referenced member var name '" + memberName
+        throw TypeCheckerException("Referenced member var name '" + memberName.str()
             + "' in class " + classType.toString() 
             + " is not a variable type");
     }
@@ -237,27 +308,12 @@ bool TypeEnv::typeIsOrBase(Type const& t1, Type const& t2) const
     if (t1.isValue() && t2.isValue())
     {
         // Testing base/derived only makes sense with ValueTypes.
-        ValueType const t1v = t1.value();
-        ValueType const t2v = t2.value();
-        ClassMeta const* meta1 = _classes.lookup(t1v);
-        ClassMeta const* meta2 = _classes.lookup(t2v);
+        ClassMeta const* meta1 = _classes.lookup(t1.value());
+        ClassMeta const* meta2 = _classes.lookup(t2.value());
 
-        if (meta1)
+        if (meta1 && meta2)
         {
-            while (meta2)
-            {
-                if (!meta2->parent)
-                {
-                    break;
-                }
-
-                if (*meta2->parent == t1v)
-                {
-                    return true;
-                }
-
-                meta2 = _classes.lookup(*meta2->parent);
-            }
+            return meta2->isOrDerivesFrom(*meta1);
         }
     }
 
@@ -284,8 +340,51 @@ bool TypeEnv::compatibleArgs(Vector<ValueType> const& formal,
     return true;
 }
 
+// Picks from overloads (nearest class first) as the nearest class with
+//  a match would: an exact match, else its one compatible overload.
+CanonName const* TypeEnv::pickOverload(Vector<Overload> const& overloads,
+        CanonName const& exact) const
+{
+    Vector<ValueType> const& args = exact.type().args();
+
+    for (size_t first = 0, last = 0; first < overloads.size(); first = last)
+    {
+        int const depth = overloads[first].depth;
+        CanonName const* inexact = nullptr;
+
+        for (last = first; last < overloads.size() && overloads[last].depth == depth; ++last)
+        {
+            if (overloads[last].name == exact)
+            {
+                return &overloads[last].name;
+            }
+        }
+
+        for (size_t i = first; i < last; ++i)
+        {
+            if (compatibleArgs(overloads[i].name.type().args(), args))
+            {
+                if (inexact)
+                {
+                    throw TypeCheckerException("Ambiguous overloaded call of '"
+                            + exact.baseName().str() + "'");
+                }
+
+                inexact = &overloads[i].name;
+            }
+        }
+
+        if (inexact)
+        {
+            return inexact;
+        }
+    }
+
+    return nullptr;
+}
+
 CanonName TypeEnv::resolveMethod(ValueType const& classType,
-        String const& baseName, MethodType const& methodType) const
+        Symbol const& baseName, MethodType const& methodType) const
 {
     ClassMeta const* cm = _classes.lookup(classType);
 
@@ -295,56 +394,49 @@ CanonName TypeEnv::resolveMethod(ValueType const& classType,
                 + classType.toString() + "'");
     }
 
-    // Get all methods in class with this name.
-    Set<CanonName> overloadSet = cm->methods;
-    erase_if(overloadSet, [&](CanonName const& n)
-    {
-        return n.baseName() != baseName;
-    });
+    CanonName const exact(baseName, methodType);
+    Map<CanonName, CanonName>* resolved = nullptr;
 
-    // Find an exact match on args.
-    for (CanonName const& method : overloadSet)
+    // A closed class can't change, so its answers are kept.
+    if (cm->closed)
     {
-        if (method.type().args() == methodType.args())
+        resolved = &_resolved[classType];
+
+        if (CanonName const* known = lookup(*resolved, exact))
         {
-            return method;
+            return *known;
         }
     }
 
-    // Find ONE inexact match.
-    Optional<CanonName> inexact;
+    Vector<Overload> const* overloads = lookup(cm->overloads, baseName);
+    CanonName const* found = overloads ? pickOverload(*overloads, exact) : nullptr;
 
-    for (CanonName const& method : overloadSet)
+    if (!found)
     {
-        if (compatibleArgs(method.type().args(), methodType.args()))
+        // An open class has only its own methods indexed so far.
+        if (!cm->closed && cm->parent)
         {
-            if (inexact)
-            {
-                throw TypeCheckerException("Ambiguous overloaded call of '"
-                        + baseName + "'");
-            }
-
-            inexact = method;
+            return resolveMethod(*cm->parent, baseName, methodType);
         }
-    }
 
-    if (!inexact)
-    {
-        if (cm->parent)
+        ValueType root = classType;
+
+        for (ClassMeta const* c = cm; c && c->parent; c = _classes.lookup(*c->parent))
         {
-            return resolveMethod(*cm->parent, baseName, methodType);
+            root = *c->parent;
         }
-        else
-        {
-            CanonName const methodName(baseName, methodType);
 
-            throw TypeCheckerException("Undeclared method '" 
-                    + methodName.canonName() + "' in class '" 
-                    + classType.toString() + "'");
-        }
+        throw TypeCheckerException("Undeclared method '" 
+                + exact.canonName() + "' in class '" 
+                + root.toString() + "'");
     }
 
-    return *inexact;
+    if (resolved)
+    {
+        resolved->insert({ exact, *found });
+    }
+
+    return *found;
 }
 
 void TypeEnv::assertValidType(ValueType const& type) const
@@ -393,49 +485,4 @@ void TypeEnv::assertTypeIsOrBase(Type const& t1, Type const& t2) const
         );
 }
 
-void TypeEnv::initialize() 
-{
-    auto binopRule = [&](OpType op, ValueType const& ret, 
-            ValueType const& lhs, ValueType const& rhs)
-    {
-        String name(opString(op));
-        MethodType type(ret, { lhs, rhs });
-        CanonName canonName(name, type);
-        _rules.insert({ canonName, ret });
-    };
-    
-    auto unopRule = [&](OpType op, ValueType const& ret, ValueType const& rhs)
-    {
-        String name(opString(op));
-        MethodType type(ret, { rhs });
-        CanonName canonName(name, type);
-        _rules.insert({ canonName, ret });
-    };
-
-    ValueType const i = intType;
-    ValueType const b = boolType;
-    ValueType const v = voidType;
-
-    // Predefined function types. 
-    binopRule(opPlus,  i, i, i); // int +(int,int)
-    binopRule(opMinus, i, i, i);
-    binopRule(opMult,  i, i, i);
-    binopRule(opDiv,   i, i, i);
-    
-    binopRule(opLogEq,    b, i, i); // bool ==(int,int)
-    binopRule(opLogNotEq, b, i, i);
-    
-    binopRule(opLogEq,    b, b, b);
-    binopRule(opLogNotEq, b, b, b);
-   
-    binopRule(opAnd,      b, b, b); // bool &&(bool,bool)
-    binopRule(opOr,       b, b, b);
-    
-    binopRule(opAnd,      b, i, i); // bool &&(int,int)
-    binopRule(opOr,       b, i, i);
-
-    unopRule(opMinus, i, i); // int -(int)
-    unopRule(opNot,   b, b); // bool !(bool)
-}
-
 } //namespace dflat
@@ -10,6 +10,8 @@
 #include "classmeta.hpp"
 #include "scopemeta.hpp"
 #include "methodmeta.hpp"
+#include "optype.hpp"
+#include <stdexcept>
 
 namespace dflat
 {
@@ -26,7 +28,7 @@ class TypeEnv
         void enterClass(ValueType const& classType);
         void setClassParent(ValueType const&);
         void leaveClass();
-        void addClassVar(String const& name, ValueType const& type);
+        void addClassVar(Symbol const& name, ValueType const& type);
         void addClassMethod(CanonName const&);
         bool inClass() const;
         ClassMeta const& curClass() const;
@@ -35,23 +37,25 @@ class TypeEnv
         void leaveMethod();
         bool inMethod() const;
         MethodMeta const& curMethod() const;
-        void setMethodMeta(ASN const*, ValueType const& objectType, CanonName const&);
+        MethodMeta methodMeta(ValueType const& objectType, CanonName const&) const;
 
         void enterScope();
         void leaveScope();
         
-        void declareLocal(String const& name, ValueType const& type);
+        void declareLocal(Symbol const& name, ValueType const& type);
         
-        Type lookupRuleType(CanonName const&) const;
-        MethodType lookupMethodType(CanonName const&) const;
-        MethodType lookupMethodTypeByClass(ValueType const& classType,
+        // Result of a builtin operator; throws for invalid operands.
+        Type lookupOpType(OpType, ValueType const& rhs) const;
+        Type lookupOpType(OpType, ValueType const& lhs, ValueType const& rhs) const;
+        MethodType const& lookupMethodType(CanonName const&) const;
+        MethodType const& lookupMethodTypeByClass(ValueType const& classType,
                 CanonName const&) const;
-        ValueType lookupVarType(String const& varName) const;
+        ValueType lookupVarType(Symbol const& varName) const;
         ValueType lookupVarTypeByClass(ValueType const& classType,
-                String const& varName) const;
+                Symbol const& varName) const;
 
         CanonName resolveMethod(ValueType const& classType,
-                String const& baseName, MethodType const&) const;
+                Symbol const& baseName, MethodType const&) const;
         
         bool compatibleArgs(Vector<ValueType> const& formal,
                 Vector<ValueType> const& actual) const;
@@ -67,15 +71,13 @@ class TypeEnv
         void assertTypeIsOrBase(Type const& t1, Type const& t2) const;
 
     private:
-        void initialize();
-
         ClassMetaMan _classes;
         ScopeMetaMan _scopes;
-        MethodMetaMan _methods;
-    
-        /// rules - Map of valid rules for how types interact with operators:
-        ///     Map: String canonical name -> String expressions return type.
-        Map<CanonName,Type> _rules;
+
+        // resolveMethod answers by receiver class and call.
+        mutable Map<ValueType, Map<CanonName, CanonName>> _resolved;
+
+        CanonName const* pickOverload(Vector<Overload> const&, CanonName const& exact) const;
 
         Optional<MethodMeta> _curMethod;
 
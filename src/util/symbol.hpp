@@ -0,0 +1,135 @@
+#pragma once
+
+#include "string.hpp"
+#include "vector.hpp"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+namespace dflat
+{
+
+// Maps each distinct identifier to a stable small integer.
+// Interned text is never freed, so references to it stay valid.
+class SymbolTable
+{
+    struct Entry
+    {
+        String const* text;
+        size_t hash;
+    };
+
+    std::deque<String> _texts;
+    Vector<Entry> _entries;
+    std::unordered_map<std::string_view, uint32_t> _ids;
+
+    public:
+        // Id of the empty string, interned first so Symbol() needn't look.
+        static constexpr uint32_t emptyId = 0;
+
+        SymbolTable()
+        {
+            intern(std::string_view());
+        }
+
+        static SymbolTable& global()
+        {
+            static SymbolTable table;
+            return table;
+        }
+
+        uint32_t intern(std::string_view text)
+        {
+            auto it = _ids.find(text);
+
+            if (it != _ids.end())
+            {
+                return it->second;
+            }
+
+            uint32_t const id = static_cast<uint32_t>(_entries.size());
+            String const& stored = _texts.emplace_back(text);
+            _entries.push_back({ &stored, std::hash<String>{}(stored) });
+            _ids.insert({ std::string_view(stored), id });
+            return id;
+        }
+
+        String const& text(uint32_t id) const
+        {
+            return *_entries[id].text;
+        }
+
+        size_t hash(uint32_t id) const
+        {
+            return _entries[id].hash;
+        }
+
+        size_t size() const
+        {
+            return _entries.size();
+        }
+};
+
+// An interned identifier.
+// Comparing, hashing and copying cost O(1) whatever the identifier's length.
+class Symbol
+{
+    uint32_t _id;
+
+    struct FromId {};
+
+    Symbol(FromId, uint32_t id)
+        : _id(id)
+    {}
+
+    public:
+        Symbol()
+            : _id(SymbolTable::emptyId)
+        {}
+
+        Symbol(std::string_view text)
+            : _id(SymbolTable::global().intern(text))
+        {}
+
+        Symbol(String const& text)
+            : Symbol(std::string_view(text))
+        {}
+
+        Symbol(char const* text)
+            : Symbol(std::string_view(text))
+        {}
+
+        static Symbol fromId(uint32_t id)
+        {
+            return Symbol(FromId{}, id);
+        }
+
+        uint32_t id() const { return _id; }
+        size_t hash() const { return SymbolTable::global().hash(_id); }
+        String const& str() const { return SymbolTable::global().text(_id); }
+        String toString() const { return str(); }
+
+        bool operator==(Symbol const& other) const { return _id == other._id; }
+        bool operator!=(Symbol const& other) const { return _id != other._id; }
+
+        // Orders by text, so sorted output doesn't depend on intern order.
+        bool operator<(Symbol const& other) const { return str() < other.str(); }
+};
+
+} // namespace dflat
+
+namespace std
+{
+
+template <>
+struct hash<dflat::Symbol>
+{
+    size_t operator()(dflat::Symbol const& x) const
+    {
+        return x.id();
+    }
+};
+
+} // namespace std
@@ -3,7 +3,7 @@
 namespace dflat
 {
 
-Variable::Variable(Optional<String> _object, String _variable)
+Variable::Variable(Optional<Symbol> _object, Symbol _variable)
     : object(std::move(_object))
     , variable(std::move(_variable))
 {}
@@ -14,10 +14,10 @@ String Variable::toString() const
     
     if (object)
     {
-        s = *object + ".";
+        s = object->str() + ".";
     }
 
-    s += variable;
+    s += variable.str();
     return s;
 }
 
@@ -2,16 +2,17 @@
 
 #include "string.hpp"
 #include "optional.hpp"
+#include "symbol.hpp"
 
 namespace dflat
 {
 
 struct Variable
 {
-    Optional<String> object;
-    String variable;
+    Optional<Symbol> object;
+    Symbol variable;
 
-    Variable(Optional<String> object, String variable);
+    Variable(Optional<Symbol> object, Symbol variable);
 
     String toString() const;
 };
@@ -0,0 +1,200 @@
+//Benchmarks. Hidden from the default run; use: ./tests [benchmark]
+
+#include "catch2/catch.hpp"
+#include "symbol.hpp"
+#include "lexer.hpp"
+#include "lexerscan.hpp"
+#include "parser.hpp"
+#include "map.hpp"
+#include <chrono>
+#include <iostream>
+
+using namespace dflat;
+
+namespace
+{
+    // Identifiers shaped like the ones in generated Db sources.
+    Vector<String> makeNames(size_t distinct, size_t refsEach)
+    {
+        Vector<String> names;
+        names.reserve(distinct * refsEach);
+
+        for (size_t r = 0; r < refsEach; ++r)
+        {
+            for (size_t i = 0; i < distinct; ++i)
+            {
+                names.push_back("generatedIdentifierNumber_" + to_string(i));
+            }
+        }
+
+        return names;
+    }
+
+    size_t stringBytes(String const& s)
+    {
+        // Short strings live inline.
+        size_t const heap = s.capacity() > 15 ? s.capacity() + 1 : 0;
+        return sizeof(String) + heap;
+    }
+
+    // Source text with the long identifiers, indentation and comments
+    // of generated Db programs.
+    String makeSource(size_t bytes)
+    {
+        String src;
+        src.reserve(bytes + 256);
+
+        for (size_t i = 0; src.size() < bytes; ++i)
+        {
+            String const n = "generatedIdentifierNumber_" + to_string(i);
+            src += "        // Comment describing what " + n + " is for.\n";
+            src += "        int " + n + " = " + n + " + 1234567 * other_value;\n";
+        }
+
+        return src;
+    }
+
+    // ((((1 + 2) * 3 ... ) of the given depth.
+    String nestedParens(size_t depth)
+    {
+        String src = "1";
+
+        for (size_t i = 0; i < depth; ++i)
+        {
+            src = "(" + src + (i % 2 ? " * 3" : " + 2") + ")";
+        }
+
+        return src;
+    }
+
+    double lexMBPerSec(String const& src, int reps)
+    {
+        auto const t0 = std::chrono::steady_clock::now();
+        size_t count = 0;
+
+        for (int i = 0; i < reps; ++i)
+        {
+            count += tokenize(src).size();
+        }
+
+        std::chrono::duration<double> const secs = std::chrono::steady_clock::now() - t0;
+        REQUIRE( count > 0 );
+        return static_cast<double>(src.size()) * reps / secs.count() / 1e6;
+    }
+}
+
+TEST_CASE( "Interned symbols vs strings", "[.][benchmark]" )
+{
+    size_t const distinct = 2000;
+    size_t const refsEach = 50;
+    Vector<String> const names = makeNames(distinct, refsEach);
+
+    // Every phase holding its own copy vs one Symbol per reference.
+    Vector<String> strings(names.begin(), names.end());
+    Vector<Symbol> symbols(names.begin(), names.end());
+
+    size_t stringMem = 0;
+    for (String const& s : strings)
+    {
+        stringMem += stringBytes(s);
+    }
+
+    size_t symbolMem = symbols.size() * sizeof(Symbol);
+    for (size_t i = 0; i < distinct; ++i)
+    {
+        // Interned text, its table entry and its index slot, counted once.
+        symbolMem += stringBytes(names[i]) + 2 * sizeof(size_t) + 32;
+    }
+
+    std::cout << "\nIdentifier references: " << names.size()
+              << "\n  String copies: " << stringMem << " bytes"
+              << "\n  Symbols:       " << symbolMem << " bytes\n";
+
+    Map<String, int> stringMap;
+    Map<Symbol, int> symbolMap;
+
+    for (size_t i = 0; i < distinct; ++i)
+    {
+        stringMap.insert({ strings[i], static_cast<int>(i) });
+        symbolMap.insert({ symbols[i], static_cast<int>(i) });
+    }
+
+    long stringSum = 0;
+    long symbolSum = 0;
+
+    BENCHMARK( "Map<String> lookup, all references" )
+    {
+        for (String const& s : strings)
+        {
+            stringSum += stringMap.at(s);
+        }
+    }
+
+    BENCHMARK( "Map<Symbol> lookup, all references" )
+    {
+        for (Symbol const& s : symbols)
+        {
+            symbolSum += symbolMap.at(s);
+        }
+    }
+
+    BENCHMARK( "String equality, all references" )
+    {
+        for (size_t i = 1; i < strings.size(); ++i)
+        {
+            stringSum += strings[i] == strings[i - 1];
+        }
+    }
+
+    BENCHMARK( "Symbol equality, all references" )
+    {
+        for (size_t i = 1; i < symbols.size(); ++i)
+        {
+            symbolSum += symbols[i] == symbols[i - 1];
+        }
+    }
+
+    REQUIRE( symbolMem < stringMem );
+    REQUIRE( stringSum >= 0 );
+    REQUIRE( symbolSum >= 0 );
+}
+
+TEST_CASE( "Lexer throughput by scan level", "[.][benchmark]" )
+{
+    String const src = makeSource(8 << 20);
+    scan::Level const best = scan::level();
+
+    std::cout << "\nLexing " << src.size() << " bytes:\n";
+
+    for (scan::Level l : { scan::Level::scalar, scan::Level::sse2 })
+    {
+        scan::setLevel(l);
+
+        if (scan::level() != l)
+        {
+            continue; // Not supported here.
+        }
+
+        static char const* const names[] = { "scalar", "sse2" };
+        std::cout << "  " << names[static_cast<int>(l)] << ": "
+                  << lexMBPerSec(src, 5) << " MB/s\n";
+    }
+
+    scan::setLevel(best);
+}
+
+TEST_CASE( "Parsing nested parentheses", "[.][benchmark]" )
+{
+    for (size_t depth : { 4u, 7u, 200u, 2000u })
+    {
+        TokenStream const ts = tokenize(nestedParens(depth));
+
+        auto const t0 = std::chrono::steady_clock::now();
+        ASNPtr const exp = Parser(ts, false).parseExp();
+        std::chrono::duration<double, std::milli> const ms =
+            std::chrono::steady_clock::now() - t0;
+
+        REQUIRE( exp );
+        std::cout << "depth " << depth << ": " << ms.count() << " ms\n";
+    }
+}
@@ -5,21 +5,32 @@
 #include "codegenerator.hpp"
 #include "parser.hpp"
 #include "lexer.hpp"
+#include "config.hpp"
 
 using namespace dflat;
 
+TypeEnv const& testTypeEnv()
+{
+    static TypeEnv const typeEnv = []
+    {
+        TypeEnv env;
+        env.enterClass(ValueType("Object"));
+        env.addClassVar("member", intType);
+        env.addClassMethod(CanonName("method", MethodType(voidType, {})));
+        env.leaveClass();
+        return env;
+    }();
+
+    return typeEnv;
+}
+
 GenEnv testGenEnv()
 {
     ValueType objectType("Object");
     CanonName methodName("method", MethodType(voidType, {}));
 
-    TypeEnv typeEnv;
-    typeEnv.enterClass(objectType);
-    typeEnv.addClassVar("member", intType);
-    typeEnv.addClassMethod(methodName);
-    typeEnv.leaveClass();
-
-    GenEnv genEnv(typeEnv);
+    // GenEnv borrows from the TypeEnv, so it's kept for the whole run.
+    GenEnv genEnv(testTypeEnv());
     genEnv.enterClass(objectType);
     genEnv.enterMethod(methodName);
     genEnv.declareLocal("var", intType);
@@ -62,6 +73,14 @@ String strip(String const& s)
     return t;
 }
 
+// Everything env has generated, stripped.
+String generated(GenEnv& env)
+{
+    OutBuffer out;
+    env.flushTo(out);
+    return strip(out.str());
+}
+
 String codeGenExp(String const& input)
 {
     //Helper function that makes testing expression code generation less ugly
@@ -76,7 +95,7 @@ String codeGenExp(String const& input)
     }
     
     result->generateCode(env);
-    return strip(env.concat());
+    return generated(env);
 }
 
 String codeGenStm(String const& input)
@@ -93,7 +112,7 @@ String codeGenStm(String const& input)
     }
     
     result->generateCode(env);
-    return strip(env.concat());
+    return generated(env);
 }
 
 String codeGenProg(String const& input)
@@ -107,14 +126,13 @@ String codeGenProg(String const& input)
         node->generateCode(genEnv);
     }
 
-    return strip(genEnv.concat());
+    return generated(genEnv);
 }
 
 String codeGenFullProg(String const& input)
 {
     Vector<ASNPtr> program = Parser(tokenize(input)).parseProgram();
     TypeEnv typeEnv = typeCheck(program);
-    GenEnv genEnv(typeEnv);
     String output = generateCode(program,typeEnv);
     return strip(output);
 }
@@ -771,8 +789,8 @@ TEST_CASE( "Program-level Tests", "[CodeGenerator]" )
                   return p;
               }
 
-              void* dfv_Main(enum Methods);
               void* dfv_MyClass(enum Methods);
+              void* dfv_Main(enum Methods);
 
               struct df_MyClass
               {
@@ -817,20 +835,20 @@ TEST_CASE( "Program-level Tests", "[CodeGenerator]" )
                       CALL(int, dfvm_changeData_int, df_mc, 11);
               }
 
-              void* dfv_Main(enum Methods m)
+              void* dfv_MyClass(enum Methods m)
               {
                       switch (m)
                       {
-                              case dfvm_main_: return &dfm_Main_main_;
+                              case dfvm_changeData_int: return &dfm_MyClass_changeData_int;
                               default: abort();
                       }
               }
 
-              void* dfv_MyClass(enum Methods m)
+              void* dfv_Main(enum Methods m)
               {
                       switch (m)
                       {
-                              case dfvm_changeData_int: return &dfm_MyClass_changeData_int;
+                              case dfvm_main_: return &dfm_Main_main_;
                               default: abort();
                       }
               }
@@ -843,3 +861,149 @@ TEST_CASE( "Program-level Tests", "[CodeGenerator]" )
 
         )"));
 }
+
+TEST_CASE( "Arena-backed ASTs generate the same code", "[CodeGenerator]" )
+{
+    String const input = R"(
+        class Calc
+        {
+            int x;
+            cons(int x) { this.x = x; }
+            int f(int a) { return a + x * 2; }
+        };
+        class Main
+        {
+            void main()
+            {
+                Calc c = new Calc(5);
+                int i = 0;
+                while (i != 3) { if (i == 1) { print(c.f(i)); } else { i = i + 1; } }
+            }
+        };
+    )";
+
+    Vector<ASNPtr> heapProgram = parse(tokenize(input));
+    String const heapCode = generateCode(heapProgram, typeCheck(heapProgram));
+
+    ASTArena arena;
+    Vector<ASNPtr> program = parse(tokenize(input), &arena);
+    REQUIRE( arena.bytesUsed() > 0 );
+    REQUIRE( program[0]->toString() == heapProgram[0]->toString() );
+
+    String const arenaCode = generateCode(program, typeCheck(program));
+    REQUIRE( arenaCode == heapCode );
+
+    program.clear();
+    arena.release();
+    REQUIRE( arena.bytesUsed() == 0 );
+}
+
+TEST_CASE( "Inherited members resolve to their defining class", "[CodeGenerator]" )
+{
+    ValueType const a("A");
+    ValueType const b("B");
+    CanonName const f("f", intType, {});
+    ClassMetaMan classes;
+
+    classes.enter(a);
+    classes.addVar("x", intType);
+    classes.addMethod(f);
+    classes.leave();
+    classes.enter(b);
+    classes.setParent(a);
+    classes.addVar("y", intType);
+
+    // Depth counts from the class itself, even while it's open.
+    REQUIRE( classes.lookupVar(b, "y")->depth == 1 );
+    REQUIRE( classes.lookupVar(b, "x")->depth == 2 );
+    REQUIRE( classes.lookupMethod(b, f)->baseClassType == a );
+    REQUIRE( !classes.lookupVar(a, "y") );
+
+    Vector<ASNPtr> program = parse(tokenize(R"(
+        class A { int x; int f() { return 1; } };
+        class B extends A { int g() { return f(); } };
+        class C extends B { int f() { return x; } };
+        class Main { void main() { B b = new B(); print(b.g()); } };
+    )"));
+    String const code = generateCode(program, typeCheck(program));
+    REQUIRE( code.find("df_this->parent.parent.df_x") != String::npos );
+
+    // Vtables point at the method that exists.
+    REQUIRE( code.find("case dfvm_f_: return &dfm_A_f_;") != String::npos );
+    REQUIRE( code.find("case dfvm_f_: return &dfm_C_f_;") != String::npos );
+    REQUIRE( code.find("dfm_B_f_") == String::npos );
+}
+
+TEST_CASE( "GenEnv reads class metadata in place", "[CodeGenerator]" )
+{
+    ValueType const type("Shared");
+    TypeEnv typeEnv;
+    typeEnv.enterClass(type);
+
+    GenEnv genEnv(typeEnv);
+    genEnv.enterClass(type);
+    REQUIRE( &genEnv.curClass() == &typeEnv.curClass() );
+    REQUIRE_THROWS_AS( genEnv.enterClass(ValueType("Unknown")), std::logic_error );
+}
+
+TEST_CASE( "Mangled names are built once per symbol", "[CodeGenerator]" )
+{
+    ValueType const a("A");
+    ValueType const b("B");
+    CanonName const f("f", MethodType(intType, { intType, a }));
+
+    ClassMetaMan classes;
+    classes.enter(a);
+    classes.addMethod(f);
+    classes.addMethod(CanonName(config::consName, MethodType(a, {})));
+    classes.leave();
+    classes.enter(b);
+    classes.addMethod(CanonName(config::consName, MethodType(b, {})));
+    classes.leave();
+
+    MangleTable const names(classes);
+    REQUIRE( names.typeName(a) == "struct df_A*" );
+    REQUIRE( names.typeName(intType) == "int" );
+    REQUIRE( names.methodName(a, f) == "dfm_A_f_int_A" );
+    REQUIRE( names.vtableMethodName(f) == "dfvm_f_int_A" );
+    REQUIRE( &names.methodName(a, f) == &names.methodName(a, f) );
+
+    // Same canonical name, different classes.
+    REQUIRE( names.consName(CanonName(config::consName, MethodType(a, {}))) == "dfc_A_" );
+    REQUIRE( names.consName(CanonName(config::consName, MethodType(b, {}))) == "dfc_B_" );
+}
+
+TEST_CASE( "Generated C follows declaration order", "[CodeGenerator]" )
+{
+    String const input = R"(
+        class Zeta { int z() { return 1; } int a() { return 2; } };
+        class Alpha extends Zeta { int m() { return 3; } int z() { return 4; } };
+        class Mid { };
+        class Main { void main() { Alpha a = new Alpha(); print(a.z()); } };
+    )";
+
+    Vector<ASNPtr> const program = parse(tokenize(input));
+    String const code = generateCode(program, typeCheck(program));
+
+    auto before = [&code](char const* first, char const* second)
+    {
+        size_t const a = code.find(first);
+        size_t const b = code.find(second);
+        return a != String::npos && b != String::npos && a < b;
+    };
+
+    // Methods, first declared first.
+    REQUIRE( before("\tdfvm_z_,\n\tdfvm_a_,\n\tdfvm_m_,\n\tdfvm_main_,\n", "};") );
+
+    // Classes in declaration order.
+    REQUIRE( before("void* dfv_Zeta(enum Methods);\nvoid* dfv_Alpha(enum Methods);\n"
+                    "void* dfv_Mid(enum Methods);\nvoid* dfv_Main(enum Methods);\n", "struct df_Zeta") );
+    REQUIRE( before("void* dfv_Zeta(enum Methods m)", "void* dfv_Alpha(enum Methods m)") );
+    REQUIRE( before("void* dfv_Alpha(enum Methods m)", "void* dfv_Mid(enum Methods m)") );
+
+    // Inherited entries first, overrides where they were first declared.
+    REQUIRE( code.find("void* dfv_Alpha(enum Methods m)\n{\n\tswitch (m)\n\t{\n"
+                       "\t\tcase dfvm_z_: return &dfm_Alpha_z_;\n"
+                       "\t\tcase dfvm_a_: return &dfm_Zeta_a_;\n"
+                       "\t\tcase dfvm_m_: return &dfm_Alpha_m_;\n") != String::npos );
+}
@@ -3,6 +3,7 @@
 #include "catch2/catch.hpp"
 #include "token_helpers.hpp"
 #include "lexer.hpp"
+#include "lexerscan.hpp"
 
 using namespace dflat;
 
@@ -10,37 +11,20 @@ namespace dflat
 {
     //Several helper functions for the tests (further down)
 
-    template <typename T>
-    bool cmp(TokenPtr const&, TokenPtr const&) = delete;
-
-    template <>
-    bool cmp<NumberToken>(TokenPtr const& a, TokenPtr const& b)
-    {
-        return a->as<NumberToken>()->num
-            == b->as<NumberToken>()->num;
-    }
-
-    template <>
-    bool cmp<NameToken>(TokenPtr const& a, TokenPtr const& b)
+    bool cmp(Token const& a, Token const& b)
     {
-        return a->as<NameToken>()->name
-            == b->as<NameToken>()->name;
-    }
-
-    bool operator==(TokenPtr const& a, TokenPtr const& b)
-    {
-        if (a->getType() != b->getType())
+        if (a.type != b.type)
         {
             return false;
         }
 
-        switch (a->getType())
+        switch (a.type)
         {
             case tokNum: 
-                return cmp<NumberToken>(a, b);
+                return a.num == b.num;
             
             case tokVar: 
-                return cmp<NameToken>(a, b);
+                return a.sym == b.sym;
             
             case tokIf:
             case tokElse:
@@ -78,6 +62,25 @@ namespace dflat
                 return false;
         }
     }
+
+    // Compares token types and payloads, not source positions.
+    bool operator==(TokenStream const& a, TokenStream const& b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (!cmp(a[i], b[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
 }
 
 
@@ -85,11 +88,11 @@ TEST_CASE( "Lexer produces correct output", "[lexer]" )
 {
     // Exercise token printing
     {
-        Vector<TokenPtr> ts = tokenize("a b(c,d)");
-        to_string(ts);
+        TokenStream ts = tokenize("a b(c,d)");
+        REQUIRE ( to_string(ts) == "a b ( c , d )" );
 
-        TokenPtr t = std::make_unique<NameToken>("hi");
-        to_string(t);
+        TokenStream t = tokens(NameToken("hi"), NumberToken(3));
+        REQUIRE ( to_string(t) == "hi 3" );
     }
 
     // Test for empty input
@@ -233,6 +236,17 @@ TEST_CASE( "Lexer produces correct output", "[lexer]" )
     REQUIRE ( tokenize("print") == tokens(
         PrintToken()
         ));
+
+    // Near-misses of keywords are names.
+    REQUIRE ( tokenize("iff els whilee cs tris consts Print") == tokens(
+        NameToken("iff"),
+        NameToken("els"),
+        NameToken("whilee"),
+        NameToken("cs"),
+        NameToken("tris"),
+        NameToken("consts"),
+        NameToken("Print")
+        ));
     
     //Tests for multiple tokens and special cases being tokenized:
     
@@ -261,6 +275,14 @@ TEST_CASE( "Lexer produces correct output", "[lexer]" )
     REQUIRE ( tokenize("x3") == tokens( 
         NameToken("x3")
         )); 
+
+    // Repeated names intern to the same symbol.
+    {
+        TokenStream ts = tokenize("someLongName other someLongName");
+        REQUIRE ( ts[0].sym == ts[2].sym );
+        REQUIRE ( ts[0].sym != ts[1].sym );
+        REQUIRE ( ts[2].symbol().str() == "someLongName" );
+    }
     
     REQUIRE ( tokenize("({})") == tokens(
         LeftParenToken(), 
@@ -309,6 +331,21 @@ TEST_CASE( "Lexer produces correct output", "[lexer]" )
     REQUIRE ( tokenize("0 // This is a comment") == tokens(
         NumberToken(0)
         ));
+
+    REQUIRE ( tokenize("2147483647") == tokens(
+        NumberToken(2147483647)
+        ));
+
+    // Name tokens span their source text.
+    {
+        String const input = "  abc 12";
+        TokenStream ts = tokenize(input);
+        REQUIRE ( ts[0].pos == 2 );
+        REQUIRE ( ts[0].len == 3 );
+        REQUIRE ( input.substr(ts[0].pos, ts[0].len) == "abc" );
+        REQUIRE ( ts[0].symbol() == Symbol("abc") );
+        REQUIRE ( ts[1].num == 12 );
+    }
 }
 
 
@@ -325,5 +362,44 @@ TEST_CASE( "Lexer properly throws exceptions", "[lexer]" )
     REQUIRE_THROWS_AS( tokenize("x @ y"), LexerException );
 
     REQUIRE_THROWS_AS( tokenize("var$ == 56"), LexerException );
+
+    REQUIRE_THROWS_AS( tokenize("2147483648"), LexerException );
 }
 
+
+TEST_CASE( "Lexer scans the same at every scan level", "[lexer]" )
+{
+    // Runs long enough to cross 16 byte blocks, ending at every offset.
+    String input;
+    for (size_t i = 1; i < 70; ++i)
+    {
+        input += String(i, 'a') + "_9" + String(i % 7, ' ') + "\t\n";
+        input += String(i % 9 + 1, '7') + " // " + String(i, 'c') + "\n";
+    }
+    input += "// ends without a newline";
+
+    scan::Level const best = scan::level();
+    scan::setLevel(scan::Level::scalar);
+    TokenStream const scalar = tokenize(input);
+
+    scan::setLevel(scan::Level::sse2);
+    TokenStream const fast = tokenize(input);
+    REQUIRE ( fast == scalar );
+
+    for (size_t i = 0; i < scalar.size(); ++i)
+    {
+        REQUIRE ( fast[i].pos == scalar[i].pos );
+        REQUIRE ( fast[i].len == scalar[i].len );
+    }
+
+    scan::setLevel(best);
+    REQUIRE ( scalar.size() == 69 * 2 );
+}
+
+TEST_CASE( "Default Symbols are the empty identifier", "[lexer]" )
+{
+    REQUIRE( Symbol().id() == SymbolTable::emptyId );
+    REQUIRE( Symbol() == Symbol("") );
+    REQUIRE( Symbol().str().empty() );
+    REQUIRE( Symbol("x") != Symbol() );
+}
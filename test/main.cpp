@@ -1,6 +1,7 @@
 //"Main" for the Catch unit test library
 
 #define CATCH_CONFIG_RUNNER // Allow us to define our own main
+#define CATCH_CONFIG_NO_POSIX_SIGNALS // MINSIGSTKSZ is not constexpr on newer glibc
 #include "catch2/catch.hpp"
 #include "config.hpp"
 
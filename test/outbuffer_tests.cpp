@@ -0,0 +1,93 @@
+//Unit tests for the chunked output buffer
+
+#include "catch2/catch.hpp"
+#include "outbuffer.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace dflat;
+
+TEST_CASE( "OutBuffer appends across chunks", "[outbuffer]" )
+{
+    String const big(300 * 1024, 'x');
+    OutBuffer out;
+
+    out << "int " << big;
+    out.append(3, '\t');
+    REQUIRE ( out.size() == 4 + big.size() + 3 );
+    REQUIRE ( out.str() == "int " + big + "\t\t\t" );
+
+    // Splicing copies small pieces and hands big ones over.
+    OutBuffer tail;
+    tail << "};\n";
+    out.splice(std::move(tail));
+    REQUIRE ( tail.size() == 0 );
+    REQUIRE ( out.str() == "int " + big + "\t\t\t};\n" );
+
+    // Appends go after the spliced text.
+    out << "end";
+    REQUIRE ( out.str().substr(out.size() - 6) == "};\nend" );
+
+    OutBuffer whole;
+    whole.splice(std::move(out));
+    whole.splice(std::move(tail));
+    REQUIRE ( whole.str() == "int " + big + "\t\t\t};\nend" );
+    REQUIRE ( out.size() == 0 );
+}
+
+TEST_CASE( "OutBuffer writes to files", "[outbuffer]" )
+{
+    FilePath const path = "outbuffer_test.c";
+    OutBuffer out;
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        out << "print(" << to_string(i) << ");\n";
+    }
+
+    out.writeTo(path);
+
+    std::ifstream in(path);
+    std::stringstream written;
+    written << in.rdbuf();
+    REQUIRE ( written.str() == out.str() );
+
+    std::remove(path.c_str());
+
+    REQUIRE_THROWS_AS( out.writeTo("no/such/dir/out.c"), OutputException );
+}
+
+TEST_CASE( "OutBuffer streams as chunks fill", "[outbuffer]" )
+{
+    FilePath const path = "outbuffer_stream_test.c";
+    String const line(1000, 'y');
+    String expected;
+
+    {
+        OutFile file(path);
+        OutBuffer out;
+        out.streamTo(file.fd());
+
+        for (int i = 0; i < 3000; ++i)
+        {
+            out << line;
+            expected += line;
+        }
+
+        // Some went out already, and no more than a few chunks wait.
+        REQUIRE ( out.size() < expected.size() );
+        REQUIRE ( std::ifstream(path, std::ios::ate).tellg() > 0 );
+
+        out.flush();
+        REQUIRE ( out.size() == 0 );
+        file.close();
+    }
+
+    std::ifstream in(path);
+    std::stringstream written;
+    written << in.rdbuf();
+    REQUIRE ( written.str() == expected );
+
+    std::remove(path.c_str());
+}
@@ -3,6 +3,7 @@
 #include "catch2/catch.hpp"
 #include "parser.hpp"
 #include "token_helpers.hpp"
+#include "lexer.hpp"
 #include <iostream>
 
 using namespace dflat;
@@ -47,7 +48,7 @@ BlockPtr emptyBlock()
     return std::make_unique<Block>();
 }
 
-//Parser( tokens(NumberToken(1), PlusToken(), NumberToken(1)) ).parseAdditive()
+//Parser( tokens(NumberToken(1), PlusToken(), NumberToken(1)) ).parseExp()
 #define PT(method, ...) passPrint(Parser(tokens(__VA_ARGS__)).method())
 
 TEST_CASE( "Parser works correctly", "[parser]" )
@@ -119,7 +120,7 @@ TEST_CASE( "Parser works correctly", "[parser]" )
         ~VariableExp("fun")
         );
     
-    REQUIRE( PT(parseAdditive,  //1 + 1 -> BinopExp(additive)
+    REQUIRE( PT(parseExp,  //1 + 1 -> BinopExp(additive)
         NumberToken(1),
         PlusToken(),
         NumberToken(1)
@@ -132,20 +133,7 @@ TEST_CASE( "Parser works correctly", "[parser]" )
             )
         );
 
-    REQUIRE( PT(parseAdditive, //2 - 5 -> BinopExp(additive)
-        NumberToken(2),
-        MinusToken(),
-        NumberToken(5)
-        )
-        ==
-        ~BinopExp(
-            ~NumberExp(2),
-            opMinus,
-            ~NumberExp(5)
-            )
-        );
-
-    REQUIRE( PT(parseExp, //same as above but using parseExp
+    REQUIRE( PT(parseExp, //2 - 5 -> BinopExp(additive)
         NumberToken(2),
         MinusToken(),
         NumberToken(5)
@@ -173,7 +161,7 @@ TEST_CASE( "Parser works correctly", "[parser]" )
             )
         );
 
-    REQUIRE( PT(parseMultive,     //2 * 3 -> BinopExp(multive)
+    REQUIRE( PT(parseExp,     //2 * 3 -> BinopExp(multive)
                 NumberToken(2),
                 MultiplyToken(),
                 NumberToken(3)
@@ -186,7 +174,7 @@ TEST_CASE( "Parser works correctly", "[parser]" )
                  )
              );
 
-    REQUIRE( PT(parseMultive,     //10 / 5 -> BinopExp(multive)
+    REQUIRE( PT(parseExp,     //10 / 5 -> BinopExp(multive)
                 NumberToken(10),
                 DivisionToken(),
                 NumberToken(5)
@@ -199,20 +187,7 @@ TEST_CASE( "Parser works correctly", "[parser]" )
                  )
              );
 
-    REQUIRE( PT(parseExp,         //same as above but using parseExp
-                NumberToken(10),
-                DivisionToken(),
-                NumberToken(5)
-                )
-             ==
-             ~BinopExp(
-                ~NumberExp(10),
-                opDiv,
-                ~NumberExp(5)
-                 )
-             );
-
-    REQUIRE( PT(parseLogical,         //foo && bar -> BinopExp(logical)
+    REQUIRE( PT(parseExp,         //foo && bar -> BinopExp(logical)
                 NameToken("foo"),
                 AndToken(),
                 NameToken("bar")
@@ -225,20 +200,7 @@ TEST_CASE( "Parser works correctly", "[parser]" )
                  )
              );
 
-    REQUIRE( PT(parseLogical,         //foo || bar -> BinopExp(logical)
-                NameToken("foo"),
-                OrToken(),
-                NameToken("bar")
-                )
-             ==
-             ~BinopExp(
-                ~VariableExp("foo"),
-                opOr,
-                ~VariableExp("bar")
-                 )
-             );
-
-    REQUIRE( PT(parseLogical,         //same as above but using parseExp
+    REQUIRE( PT(parseExp,         //foo || bar -> BinopExp(logical)
                 NameToken("foo"),
                 OrToken(),
                 NameToken("bar")
@@ -667,31 +629,6 @@ TEST_CASE( "Parser works correctly", "[parser]" )
         nullptr
         );
 
-    REQUIRE( PT(parseAdditive,      //parse is not Additive
-                NumberToken(2)
-                )
-             ==
-             nullptr
-             );
-
-    REQUIRE( PT(parseAdditive,      //parse is not Additive
-                NumberToken(2),
-                MultiplyToken(),
-                NumberToken(3)
-                )
-             ==
-             nullptr
-             );
-
-    REQUIRE( PT(parseMultive,      //parse is not Multive
-                NumberToken(2),
-                PlusToken(),
-                NumberToken(3)
-                )
-             ==
-             nullptr
-             );
-
     REQUIRE( PT(parseUnary,           //parse is not Unary
                 NameToken("var")
                 )
@@ -771,7 +708,7 @@ TEST_CASE( "Parser properly throws exceptions", "[parser]" )
              ParserException
              );
 
-    REQUIRE_THROWS_AS( PT(parseAdditive,  //1 + -> expected expression after '+'
+    REQUIRE_THROWS_AS( PT(parseExp,  //1 + -> expected expression after '+'
         NumberToken(1),
         PlusToken()
         ),
@@ -784,7 +721,7 @@ TEST_CASE( "Parser properly throws exceptions", "[parser]" )
             ParserException
             );
 
-    REQUIRE_THROWS_AS( PT(parseAdditive,  //1 + - -> expected expresion after unary -
+    REQUIRE_THROWS_AS( PT(parseExp,  //1 + - -> expected expresion after unary -
         NumberToken(1),
         PlusToken(),
         MinusToken()
@@ -825,3 +762,94 @@ TEST_CASE( "Parser properly throws exceptions", "[parser]" )
             ParserException
             );
 }
+
+TEST_CASE( "Parser handles deep nesting", "[parser]" )
+{
+    auto nested = [](size_t depth)
+    {
+        String src = "1";
+        for (size_t i = 0; i < depth; ++i)
+        {
+            src = "(" + src + (i % 2 ? " * 3" : " - x") + ")";
+        }
+        return tokenize(src);
+    };
+
+    REQUIRE ( Parser(nested(2), false).parseExp()->toString()
+            == Parser(tokens(
+                LeftParenToken(),
+                LeftParenToken(), NumberToken(1), MinusToken(), NameToken("x"), RightParenToken(),
+                MultiplyToken(), NumberToken(3),
+                RightParenToken()
+                ), false).parseExp()->toString() );
+
+    // Deep nesting parses in one pass.
+    REQUIRE ( Parser(nested(100), false).parseExp() );
+}
+
+TEST_CASE( "Parser climbs precedence right-associatively", "[parser]" )
+{
+    // 1 * 2 - 3 * 4 - 5 -> (1 * 2) - ((3 * 4) - 5)
+    REQUIRE( PT(parseExp,
+        NumberToken(1), MultiplyToken(), NumberToken(2), MinusToken(),
+        NumberToken(3), MultiplyToken(), NumberToken(4), MinusToken(),
+        NumberToken(5)
+        )
+        ==
+        ~BinopExp(
+            ~BinopExp(~NumberExp(1), opMult, ~NumberExp(2)),
+            opMinus,
+            ~BinopExp(
+                ~BinopExp(~NumberExp(3), opMult, ~NumberExp(4)),
+                opMinus,
+                ~NumberExp(5)
+                )
+            )
+        );
+
+    // a == 1 + 2 && b -> a == ((1 + 2) && b)
+    REQUIRE( PT(parseExp,
+        NameToken("a"), EqToken(), NumberToken(1), PlusToken(),
+        NumberToken(2), AndToken(), NameToken("b")
+        )
+        ==
+        ~BinopExp(
+            ~VariableExp("a"),
+            opLogEq,
+            ~BinopExp(
+                ~BinopExp(~NumberExp(1), opPlus, ~NumberExp(2)),
+                opAnd,
+                ~VariableExp("b")
+                )
+            )
+        );
+}
+
+TEST_CASE( "Parser picks statements by lookahead", "[parser]" )
+{
+    REQUIRE( PT(parseStm,   // this.x = 1;
+        ThisToken(), MemberToken(), NameToken("x"), AssignToken(),
+        NumberToken(1), SemiToken()
+        )
+        ==
+        ~AssignStm(~VariableExp("this", "x"), ~NumberExp(1))
+        );
+
+    REQUIRE( PT(parseStm,   // a.f();
+        NameToken("a"), MemberToken(), NameToken("f"), LeftParenToken(),
+        RightParenToken(), SemiToken()
+        )
+        ==
+        ~MethodStm(~MethodExp(Variable("a", "f"), Vector<ASNPtr>{}))
+        );
+
+    // No rule can start with these.
+    REQUIRE( PT(parseStm, NameToken("a"), MemberToken(), NumberToken(5)) == nullptr );
+    REQUIRE( PT(parseStm, NameToken("a"), SemiToken()) == nullptr );
+    REQUIRE( PT(parseStm, ElseToken()) == nullptr );
+    REQUIRE( PT(parseClassStm, NumberToken(1)) == nullptr );
+
+    // Committed once the lookahead matches.
+    REQUIRE_THROWS_AS( PT(parseStm, NameToken("int"), NameToken("x"), NumberToken(1)),
+        ParserException );
+}
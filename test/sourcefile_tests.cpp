@@ -0,0 +1,42 @@
+//Unit tests for reading source input
+
+#include "catch2/catch.hpp"
+#include "sourcefile.hpp"
+#include "lexer.hpp"
+#include <cstdio>
+#include <fstream>
+
+using namespace dflat;
+
+TEST_CASE( "SourceFile maps files for the lexer", "[sourcefile]" )
+{
+    FilePath const path = "sourcefile_test.db";
+    String const contents = "class Main { void main() { print(1); } };\n";
+
+    {
+        std::ofstream out(path);
+        out << contents;
+    }
+
+    {
+        SourceFile file(path);
+        REQUIRE ( file.isMapped() );
+        REQUIRE ( file.text() == contents );
+        REQUIRE ( tokenize(file.text()).size() == 16 );
+    }
+
+    // Empty files are fine too.
+    {
+        std::ofstream out(path);
+    }
+
+    {
+        SourceFile file(path);
+        REQUIRE ( file.text().empty() );
+        REQUIRE ( tokenize(file.text()).empty() );
+    }
+
+    std::remove(path.c_str());
+
+    REQUIRE_THROWS_AS( SourceFile("no/such/file.db"), SourceFileException );
+}
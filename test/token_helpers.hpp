@@ -7,12 +7,12 @@
 
 using namespace dflat;
 
-// Convenience function for making Token vectors to test against.
+// Convenience function for making TokenStreams to test against.
 template <typename... Ts>
-dflat::Vector<dflat::TokenPtr> tokens(Ts&&... in)
+dflat::TokenStream tokens(Ts&&... in)
 {
-    dflat::Vector<dflat::TokenPtr> out;
-    (out.push_back(std::make_unique<Ts>(in)), ...);
+    dflat::TokenStream out;
+    (out.append(in), ...);
     return out;
 }
 
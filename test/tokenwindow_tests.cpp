@@ -0,0 +1,110 @@
+//Unit tests for the parser's lookahead window over streamed tokens
+
+#include "catch2/catch.hpp"
+#include "tokenwindow.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+
+using namespace dflat;
+
+namespace
+{
+    TokenWindow numbers(int count, size_t capacity)
+    {
+        TokenStream ts;
+        for (int i = 0; i < count; ++i)
+        {
+            ts.append(NumberToken(i));
+        }
+
+        return TokenWindow(std::make_unique<TokenStreamProducer>(ts), capacity);
+    }
+}
+
+TEST_CASE( "TokenWindow pulls, grows and releases", "[tokenwindow]" )
+{
+    TokenWindow w = numbers(10, 4);
+
+    // Pulls on demand.
+    REQUIRE ( w.buffered() == 0 );
+    REQUIRE ( w.at(0).num == 0 );
+    REQUIRE ( w.buffered() == 1 );
+
+    // Looking further ahead than the ring holds grows it, in order.
+    REQUIRE ( w.at(6).num == 6 );
+    REQUIRE ( w.capacity() == 8 );
+    for (int i = 0; i <= 6; ++i)
+    {
+        REQUIRE ( w.at(static_cast<size_t>(i)).num == i );
+    }
+
+    // Indices stay absolute after a release.
+    w.release(5);
+    REQUIRE ( w.buffered() == 2 );
+    REQUIRE ( w.at(5).num == 5 );
+    REQUIRE ( w.at(9).num == 9 );
+
+    // Past the last token.
+    REQUIRE ( !w.atEnd(9) );
+    REQUIRE ( w.at(10).type == tokEnd );
+    REQUIRE ( w.atEnd(10) );
+    REQUIRE ( w.atEnd(11) );
+}
+
+TEST_CASE( "TokenWindow stays bounded by lookahead", "[tokenwindow]" )
+{
+    TokenWindow w = numbers(1000, 4);
+
+    // Reading two ahead and releasing behind, as the parser does.
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        REQUIRE ( w.at(i).num == static_cast<int>(i) );
+        w.at(i + 1);
+        w.release(i);
+    }
+
+    REQUIRE ( w.capacity() == 4 );
+
+    // Released tokens are gone.
+    REQUIRE_THROWS_AS( w.at(998), std::logic_error );
+}
+
+TEST_CASE( "Parsing a long class keeps the window small", "[tokenwindow]" )
+{
+    String src = "class Main { int x; void main() { int i = 0;";
+    for (int i = 0; i < 2000; ++i)
+    {
+        src += " while (i != 3) { if (i == 2) { i = i + 1; } else { print(i); } }";
+    }
+    src += " }";
+    for (int i = 0; i < 500; ++i)
+    {
+        src += " int f" + std::to_string(i) + "(int a) { x = a; return a; }";
+    }
+    src += " };";
+
+    Parser p(streamTokens(src));
+    Vector<ASNPtr> const program = p.parseProgram();
+
+    REQUIRE ( program.size() == 1 );
+    REQUIRE ( p.windowCapacity() <= 64 );
+}
+
+TEST_CASE( "Streamed and batch parses agree", "[tokenwindow]" )
+{
+    String const src =
+        "class A { int x; cons(int y) { this.x = y; } int f(int a) { return a * (x + 1); } };"
+        "class Main { void main() { A a = new A(2); print(a.f(3)); int i = 3; "
+        "while (i != 0 && true) { if (i == 2) { print(i); } else { i = i - 1; } } } };";
+
+    Vector<ASNPtr> const batch = parse(tokenize(src));
+    Vector<ASNPtr> const streamed = parse(streamTokens(src));
+
+    REQUIRE ( batch.size() == streamed.size() );
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        REQUIRE ( batch[i]->toString() == streamed[i]->toString() );
+    }
+
+    REQUIRE_THROWS_AS( parse(streamTokens("class Main { $ };")), LexerException );
+}
@@ -4,6 +4,7 @@
 #include "typechecker.hpp"
 #include "lexer.hpp"
 #include "token_helpers.hpp"
+#include "config.hpp"
 
 using namespace dflat;
 
@@ -33,7 +34,7 @@ Type stmType(String const& input)
     return asn->typeCheck(env);
 }
 
-Vector<ASNPtr> parseTest(Vector<TokenPtr> const& tokens)
+Vector<ASNPtr> parseTest(TokenStream const& tokens)
 {
     //Calls parse with a flag that does not require a "Main" in dflat code
     Parser p(tokens,false);
@@ -103,6 +104,177 @@ TEST_CASE( "TypeChecker correctly checks types", "[TypeChecker]" )
 
 
 
+TEST_CASE( "Types are stored once and compared by id", "[TypeChecker]" )
+{
+    Type const a = MethodType(intType, { boolType, ValueType("Test") });
+    Type const b = MethodType(ValueType("int"), { boolType, ValueType("Test") });
+    Type const c = MethodType(intType, { boolType });
+
+    REQUIRE( a == b );
+    REQUIRE( a.id() == b.id() );
+    REQUIRE( a != c );
+    REQUIRE( &a.method() == &b.method() );
+    REQUIRE( a.toString() == "int(bool,Test)" );
+
+    REQUIRE( Type(intType) == Type(ValueType("int")) );
+    REQUIRE( Type(intType) != Type(boolType) );
+    REQUIRE( Type(intType).isValue() );
+    REQUIRE( !Type(intType).isMethod() );
+    REQUIRE( Type::fromId(a.id()) == a );
+    REQUIRE_THROWS_AS( a.value(), std::logic_error );
+}
+
+TEST_CASE( "Canonical names key on base name and argument types", "[TypeChecker]" )
+{
+    CanonName const f(Symbol("f"), MethodType(intType, { boolType, intType }));
+    CanonName const g(Symbol("f"), voidType, { boolType, intType });
+    CanonName const h(Symbol("f"), intType, { intType, boolType });
+
+    // Return type is carried but not compared.
+    REQUIRE( f == g );
+    REQUIRE( std::hash<CanonName>{}(f) == std::hash<CanonName>{}(g) );
+    REQUIRE( f.type().ret() == intType );
+    REQUIRE( g.type().ret() == voidType );
+
+    REQUIRE( f != h );
+    REQUIRE( f != CanonName(Symbol("g"), intType, { boolType, intType }) );
+    REQUIRE( f.canonName() == "f(bool,int)" );
+}
+
+TEST_CASE( "Builtin operators are typed by table", "[TypeChecker]" )
+{
+    TypeEnv const env;
+    ValueType const object("Object");
+
+    REQUIRE( env.lookupOpType(opPlus, intType, intType) == intType );
+    REQUIRE( env.lookupOpType(opLogEq, boolType, boolType) == boolType );
+    REQUIRE( env.lookupOpType(opOr, intType, intType) == boolType );
+    REQUIRE( env.lookupOpType(opMinus, intType) == intType );
+    REQUIRE( env.lookupOpType(opNot, boolType) == boolType );
+
+    REQUIRE_THROWS_AS( env.lookupOpType(opNot, intType), TypeCheckerException );
+    REQUIRE_THROWS_AS( env.lookupOpType(opMult, intType), TypeCheckerException );
+    REQUIRE_THROWS_AS( env.lookupOpType(opLogEq, intType, boolType), TypeCheckerException );
+
+    // Class operands never match, not even a unary operator's row.
+    REQUIRE_THROWS_AS( env.lookupOpType(opMinus, object, intType), TypeCheckerException );
+    REQUIRE_THROWS_WITH( env.lookupOpType(opLogEq, object, object),
+            Catch::Contains("==(Object,Object)") );
+}
+
+TEST_CASE( "Overloads resolve from the nearest class first", "[TypeChecker]" )
+{
+    TypeEnv env;
+    ValueType const base("Base");
+    ValueType const sub("Sub");
+    auto call = [](std::initializer_list<ValueType> args)
+    {
+        return MethodType(undefinedType, args);
+    };
+
+    env.enterClass(base);
+    env.addClassMethod(CanonName("f", MethodType(intType, { intType })));
+    env.addClassMethod(CanonName("g", MethodType(intType, { base })));
+    env.addClassMethod(CanonName("h", MethodType(intType, { base, sub })));
+    env.addClassMethod(CanonName("h", MethodType(intType, { sub, base })));
+    env.leaveClass();
+
+    env.enterClass(sub);
+    env.setClassParent(base);
+    env.addClassMethod(CanonName("f", MethodType(boolType, { boolType })));
+
+    // While open: own methods, then the parent's.
+    REQUIRE( env.resolveMethod(sub, "f", call({ boolType })).type().ret() == boolType );
+    REQUIRE( env.resolveMethod(sub, "f", call({ intType })).type().ret() == intType );
+    env.leaveClass();
+
+    // Once closed: inherited ones are indexed too, and answers kept.
+    for (int i = 0; i < 2; ++i)
+    {
+        REQUIRE( env.resolveMethod(sub, "f", call({ boolType })).type().ret() == boolType );
+        REQUIRE( env.resolveMethod(sub, "f", call({ intType })).type().ret() == intType );
+        REQUIRE( env.resolveMethod(sub, "g", call({ sub })) == CanonName("g", intType, { base }) );
+    }
+
+    REQUIRE_THROWS_WITH( env.resolveMethod(sub, "h", call({ sub, sub })),
+            Catch::Contains("Ambiguous") );
+    REQUIRE( env.resolveMethod(sub, "h", call({ sub, base })) == CanonName("h", intType, { sub, base }) );
+    REQUIRE_THROWS_WITH( env.resolveMethod(sub, "f", call({ sub })),
+            Catch::Contains("'f(Sub)' in class 'Base'") );
+}
+
+TEST_CASE( "Subtype tests use the class display", "[TypeChecker]" )
+{
+    TypeEnv env;
+    ValueType const a("A");
+    ValueType const b("B");
+    ValueType const c("C");
+    ValueType const d("D");
+
+    // A <- B <- C, and A <- D.
+    env.enterClass(a);
+    env.leaveClass();
+    env.enterClass(b);
+    env.setClassParent(a);
+    env.leaveClass();
+    env.enterClass(c);
+    env.setClassParent(b);
+
+    // Usable while C is still open.
+    REQUIRE( env.typeIsOrBase(a, c) );
+    env.leaveClass();
+    env.enterClass(d);
+    env.setClassParent(a);
+    env.leaveClass();
+
+    REQUIRE( env.typeIsOrBase(c, c) );
+    REQUIRE( env.typeIsOrBase(b, c) );
+    REQUIRE( env.typeIsOrBase(a, d) );
+    REQUIRE( !env.typeIsOrBase(c, b) );
+    REQUIRE( !env.typeIsOrBase(b, d) );
+    REQUIRE( !env.typeIsOrBase(d, c) );
+    REQUIRE( !env.typeIsOrBase(intType, c) );
+}
+
+TEST_CASE( "Scopes shadow and restore declarations", "[TypeChecker]" )
+{
+    ScopeMetaMan scopes;
+    scopes.declLocal("x", intType);
+
+    scopes.push();
+    scopes.declLocal("x", boolType);
+    scopes.declLocal("x", intType); // First in a scope wins.
+    scopes.declLocal("y", intType);
+    REQUIRE( scopes.lookup("x")->type == boolType );
+
+    scopes.push();
+    REQUIRE( scopes.lookup("y")->type == intType );
+    scopes.pop();
+    scopes.pop();
+
+    REQUIRE( scopes.lookup("x")->type == intType );
+    REQUIRE( scopes.lookup("y") == nullptr );
+    REQUIRE( scopes.lookup("z") == nullptr );
+}
+
+TEST_CASE( "Calls keep their resolved method on the node", "[TypeChecker]" )
+{
+    Vector<ASNPtr> program = parseTest(tokenize(R"(
+        class Base { int f() { return 1; } };
+        class Sub extends Base { Sub g() { f(); return new Sub(); } };
+        )"));
+    typeCheck(program);
+
+    auto const& g = static_cast<MethodDef const&>(*static_cast<ClassDecl const&>(*program[1]).members[0]);
+    auto const& call = static_cast<MethodExp const&>(*static_cast<MethodStm const&>(*g.statements->statements[0]).methodExp);
+    auto const& make = static_cast<NewExp const&>(*static_cast<RetStm const&>(*g.statements->statements[1]).value);
+
+    REQUIRE( call.callMeta->thisType == ValueType("Base") );
+    REQUIRE( call.callMeta->methodName == CanonName("f", intType, {}) );
+    REQUIRE( make.callMeta->thisType == ValueType("Sub") );
+    REQUIRE( make.callMeta->methodName.baseName() == config::consName );
+}
+
 TEST_CASE( "TypeChecker checks structured code without exceptions","[TypeChecker]" )
 {
 